@@ -1249,6 +1249,19 @@ public:
     
     // Construct schema validator
     rapidjson::SchemaDocument schema_document(doc);
+    parse<ParseFlags>(str, schema_document);
+  }
+
+  // Validates against an already compiled schema. The schema document is only
+  // read, so one instance can be shared by concurrent parse calls.
+  void parse(const string_ref_type& str, const rapidjson::SchemaDocument& schema_document)
+  {
+    parse<0>(str, schema_document);
+  }
+
+  template <unsigned ParseFlags>
+  void parse(const string_ref_type& str, const rapidjson::SchemaDocument& schema_document)
+  {
     rapidjson::SchemaValidator schema_validator(schema_document);
 
     // Parse using rabbit style parse call
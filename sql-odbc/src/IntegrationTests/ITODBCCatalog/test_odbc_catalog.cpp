@@ -420,6 +420,37 @@ TEST_F(TestSQLColumns, FlightsValidation) {
     EXPECT_EQ(column_idx, static_cast< size_t >(25));
 }
 
+// Metadata cache
+TEST_F(TestSQLColumns, MetadataCache) {
+    SQLFreeHandle(SQL_HANDLE_STMT, m_hstmt);
+    SQLDisconnect(m_conn);
+    SQLFreeHandle(SQL_HANDLE_ENV, m_env);
+    std::wstring cached_conn_string = conn_string + L"metadataCacheTTL=60;";
+    AllocStatement((SQLTCHAR*)cached_conn_string.c_str(), &m_env, &m_conn,
+                   &m_hstmt, true, true);
+
+    auto CountColumns = [&]() {
+        EXPECT_EQ(SQL_SUCCESS,
+                  SQLColumns(m_hstmt, NULL, SQL_NTS, NULL, SQL_NTS,
+                             (SQLTCHAR*)L"opensearch_dashboards_sample_data_flights",
+                             SQL_NTS, NULL, SQL_NTS));
+        size_t result_count = 0;
+        while (SQLFetch(m_hstmt) == SQL_SUCCESS)
+            result_count++;
+        EXPECT_EQ(SQL_SUCCESS, SQLFreeStmt(m_hstmt, SQL_CLOSE));
+        return result_count;
+    };
+
+    // The second call is answered from the cache, the third one queries the
+    // server again after the cache is cleared
+    EXPECT_EQ(flights_column_name.size(), CountColumns());
+    EXPECT_EQ(flights_column_name.size(), CountColumns());
+    const SQLINTEGER clear_metadata_cache = 65550;
+    EXPECT_EQ(SQL_SUCCESS, SQLSetConnectAttr(m_conn, clear_metadata_cache,
+                                             (SQLPOINTER)1, 0));
+    EXPECT_EQ(flights_column_name.size(), CountColumns());
+}
+
 // We expect an empty result set for PrimaryKeys and ForeignKeys
 // Tableau specified catalog and table
 // NULL args
@@ -226,6 +226,21 @@ TEST_F(TestSQLExecute, Success) {
     LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
 }
 
+TEST_F(TestSQLExecute, ExecuteTwice) {
+    SQLRETURN ret = SQLPrepare(m_hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS);
+    LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
+    ASSERT_EQ(SQL_SUCCESS, ret);
+    ret = SQLExecute(m_hstmt);
+    LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
+    ASSERT_EQ(SQL_SUCCESS, ret);
+    EXPECT_TRUE(SQL_SUCCEEDED(SQLFetch(m_hstmt)));
+    EXPECT_TRUE(SQL_SUCCEEDED(SQLFreeStmt(m_hstmt, SQL_CLOSE)));
+    ret = SQLExecute(m_hstmt);
+    EXPECT_EQ(SQL_SUCCESS, ret);
+    LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
+    EXPECT_TRUE(SQL_SUCCEEDED(SQLFetch(m_hstmt)));
+}
+
 TEST_F(TestSQLExecute, ResetPrepareError) {
     SQLRETURN ret = SQLPrepare(m_hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS);
     LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
@@ -293,6 +308,67 @@ TEST_F(TestSQLExecDirect, NullQueryError) {
     LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
 }
 
+TEST_F(TestSQLExecDirect, AsyncExecution) {
+    ASSERT_EQ(SQL_SUCCESS,
+              SQLSetStmtAttr(m_hstmt, SQL_ATTR_ASYNC_ENABLE,
+                             (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0));
+    SQLULEN async_enable = SQL_ASYNC_ENABLE_OFF;
+    ASSERT_EQ(SQL_SUCCESS, SQLGetStmtAttr(m_hstmt, SQL_ATTR_ASYNC_ENABLE,
+                                          &async_enable, 0, NULL));
+    EXPECT_EQ((SQLULEN)SQL_ASYNC_ENABLE_ON, async_enable);
+
+    // Poll with the same arguments until the executor finished the query
+    SQLRETURN ret = SQLExecDirect(m_hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS);
+    EXPECT_EQ(SQL_STILL_EXECUTING, ret);
+    while (ret == SQL_STILL_EXECUTING) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ret = SQLExecDirect(m_hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS);
+    }
+    EXPECT_EQ(SQL_SUCCESS, ret);
+    LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
+
+    int row_count = 0;
+    while (SQL_SUCCEEDED(ret = SQLFetch(m_hstmt))
+           || ret == SQL_STILL_EXECUTING) {
+        if (ret != SQL_STILL_EXECUTING)
+            row_count++;
+    }
+    EXPECT_EQ(SQL_NO_DATA, ret);
+    EXPECT_EQ(5, row_count);
+}
+
+TEST_F(TestSQLExecDirect, AsyncSequenceError) {
+    ASSERT_EQ(SQL_SUCCESS,
+              SQLSetStmtAttr(m_hstmt, SQL_ATTR_ASYNC_ENABLE,
+                             (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0));
+    ASSERT_EQ(SQL_STILL_EXECUTING,
+              SQLExecDirect(m_hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS));
+
+    // Another asynchronous function may not run before the query finished
+    SQLRETURN ret = SQLExecute(m_hstmt);
+    EXPECT_EQ(SQL_ERROR, ret);
+    EXPECT_TRUE(CheckSQLSTATE(SQL_HANDLE_STMT, m_hstmt,
+                              SQLSTATE_FUNCTION_SEQUENCE_ERROR));
+
+    // Nor may any other statement function, the query stays pending
+    SQLSMALLINT column_count = 0;
+    EXPECT_EQ(SQL_ERROR, SQLNumResultCols(m_hstmt, &column_count));
+    EXPECT_TRUE(CheckSQLSTATE(SQL_HANDLE_STMT, m_hstmt,
+                              SQLSTATE_FUNCTION_SEQUENCE_ERROR));
+    EXPECT_EQ(SQL_ERROR, SQLFreeStmt(m_hstmt, SQL_CLOSE));
+    EXPECT_EQ(SQL_ERROR, SQLFreeHandle(SQL_HANDLE_STMT, m_hstmt));
+    EXPECT_TRUE(CheckSQLSTATE(SQL_HANDLE_STMT, m_hstmt,
+                              SQLSTATE_FUNCTION_SEQUENCE_ERROR));
+
+    ret = SQL_STILL_EXECUTING;
+    while (ret == SQL_STILL_EXECUTING) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ret = SQLExecDirect(m_hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS);
+    }
+    EXPECT_EQ(SQL_SUCCESS, ret);
+    EXPECT_EQ(SQL_SUCCESS, SQLNumResultCols(m_hstmt, &column_count));
+}
+
 TEST_F(TestSQLSetCursorName, Success) {
     SQLRETURN ret =
         SQLSetCursorName(m_hstmt, (SQLTCHAR*)m_cursor_name.c_str(), SQL_NTS);
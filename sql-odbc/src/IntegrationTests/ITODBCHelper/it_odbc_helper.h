@@ -22,6 +22,7 @@
 #define SQLSTATE_STRING_DATA_RIGHT_TRUNCATED (SQLWCHAR*)L"01004"
 #define SQLSTATE_INVALID_DESCRIPTOR_INDEX (SQLWCHAR*)L"07009"
 #define SQLSTATE_GENERAL_ERROR (SQLWCHAR*)L"HY000"
+#define SQLSTATE_FUNCTION_SEQUENCE_ERROR (SQLWCHAR*)L"HY010"
 #define SQLSTATE_INVALID_DESCRIPTOR_FIELD_IDENTIFIER (SQLWCHAR*)L"HY091"
 
 #define IT_SIZEOF(x) (NULL == (x) ? 0 : (sizeof((x)) / sizeof((x)[0])))
@@ -121,6 +121,87 @@ TEST_F(TestPagination, DisablePagination) {
     EXPECT_EQ(total_rows, GetTotalRowsAfterQueryExecution());
 }
 
+TEST_F(TestPagination, StreamingCursor) {
+    // Small pages make the forward only cursor release rows many times
+    int total_rows = 13059;
+    std::wstring streaming_conn_string =
+        use_ssl ? L"Driver={OpenSearch ODBC};"
+                  L"host=https://localhost;port=9200;"
+                  L"user=admin;password=admin;auth=BASIC;useSSL="
+                  L"1;hostnameVerification=0;logLevel=0;logOutput=C:\\;"
+                  L"responseTimeout=10;fetchSize=15;streamingCursor=1;"
+                : L"Driver={OpenSearch ODBC};"
+                  L"host=localhost;port=9200;"
+                  L"user=admin;password=admin;auth=BASIC;useSSL="
+                  L"0;hostnameVerification=0;logLevel=0;logOutput=C:\\;"
+                  L"responseTimeout=10;fetchSize=15;streamingCursor=1;";
+    ASSERT_EQ(SQL_SUCCESS,
+              SQLDriverConnect(
+                  m_conn, NULL, (SQLTCHAR*)streaming_conn_string.c_str(),
+                  SQL_NTS, m_out_conn_string, IT_SIZEOF(m_out_conn_string),
+                  &m_out_conn_string_length, SQL_DRIVER_PROMPT));
+    EXPECT_EQ(total_rows, GetTotalRowsAfterQueryExecution());
+}
+
+TEST_F(TestPagination, CloseCursorBeforeLastPage) {
+    // Closing the statement after the first rows stops the page retrieval,
+    // the connection is usable again straight away
+    int total_rows = 13059;
+    std::wstring fetch_size_15_conn_string =
+        use_ssl ? L"Driver={OpenSearch ODBC};"
+                  L"host=https://localhost;port=9200;"
+                  L"user=admin;password=admin;auth=BASIC;useSSL="
+                  L"1;hostnameVerification=0;logLevel=0;logOutput=C:\\;"
+                  L"responseTimeout=10;fetchSize=15;"
+                : L"Driver={OpenSearch ODBC};"
+                  L"host=localhost;port=9200;"
+                  L"user=admin;password=admin;auth=BASIC;useSSL="
+                  L"0;hostnameVerification=0;logLevel=0;logOutput=C:\\;"
+                  L"responseTimeout=10;fetchSize=15;";
+    ASSERT_EQ(SQL_SUCCESS,
+              SQLDriverConnect(
+                  m_conn, NULL, (SQLTCHAR*)fetch_size_15_conn_string.c_str(),
+                  SQL_NTS, m_out_conn_string, IT_SIZEOF(m_out_conn_string),
+                  &m_out_conn_string_length, SQL_DRIVER_PROMPT));
+
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+    ASSERT_EQ(SQL_SUCCESS, SQLAllocHandle(SQL_HANDLE_STMT, m_conn, &hstmt));
+    ASSERT_EQ(SQL_SUCCESS,
+              SQLExecDirect(hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS));
+    EXPECT_EQ(SQL_SUCCESS, SQLFetch(hstmt));
+    EXPECT_EQ(SQL_SUCCESS, SQLCloseCursor(hstmt));
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+
+    EXPECT_EQ(total_rows, GetTotalRowsAfterQueryExecution());
+}
+
+TEST_F(TestPagination, CancelIdleStatement) {
+    // Without a running request SQLCancel has nothing to interrupt
+    std::wstring fetch_size_15_conn_string =
+        use_ssl ? L"Driver={OpenSearch ODBC};"
+                  L"host=https://localhost;port=9200;"
+                  L"user=admin;password=admin;auth=BASIC;useSSL="
+                  L"1;hostnameVerification=0;logLevel=0;logOutput=C:\\;"
+                  L"responseTimeout=10;fetchSize=15;"
+                : L"Driver={OpenSearch ODBC};"
+                  L"host=localhost;port=9200;"
+                  L"user=admin;password=admin;auth=BASIC;useSSL="
+                  L"0;hostnameVerification=0;logLevel=0;logOutput=C:\\;"
+                  L"responseTimeout=10;fetchSize=15;";
+    ASSERT_EQ(SQL_SUCCESS,
+              SQLDriverConnect(
+                  m_conn, NULL, (SQLTCHAR*)fetch_size_15_conn_string.c_str(),
+                  SQL_NTS, m_out_conn_string, IT_SIZEOF(m_out_conn_string),
+                  &m_out_conn_string_length, SQL_DRIVER_PROMPT));
+
+    ASSERT_EQ(SQL_SUCCESS, SQLAllocHandle(SQL_HANDLE_STMT, m_conn, &m_hstmt));
+    ASSERT_EQ(SQL_SUCCESS,
+              SQLExecDirect(m_hstmt, (SQLTCHAR*)m_query.c_str(), SQL_NTS));
+    EXPECT_EQ(SQL_SUCCESS, SQLCancel(m_hstmt));
+    EXPECT_EQ(SQL_SUCCESS, SQLFetch(m_hstmt));
+    SQLFreeHandle(SQL_HANDLE_STMT, m_hstmt);
+}
+
 int main(int argc, char** argv) {
 #ifdef __APPLE__
     // Enable malloc logging for detecting memory leaks.
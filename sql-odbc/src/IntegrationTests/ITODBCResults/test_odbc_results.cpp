@@ -744,6 +744,54 @@ TEST_F(TestSQLExtendedFetch, MultiCol_MultiRow_MultiFetch_Misaligned) {
                                            multi_col, &m_hstmt));
 }
 
+TEST_F(TestSQLExtendedFetch, ColumnWiseArrays_MatchSingleRowFetch) {
+    const std::wstring columns = single_integer_col + L", " + single_float_col;
+    std::vector< SQLINTEGER > delays(multi_row_cnt);
+    std::vector< SQLDOUBLE > distances(multi_row_cnt);
+    std::vector< SQLLEN > delay_ind(multi_row_cnt);
+    std::vector< SQLLEN > distance_ind(multi_row_cnt);
+    SQLULEN rows_fetched = 0;
+
+    SQLRETURN ret = SQLSetStmtAttr(
+        m_hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)multi_row_cnt, 0);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    ret = SQLSetStmtAttr(m_hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rows_fetched, 0);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    ExecuteQuery(columns, flight_data_set, multi_row, &m_hstmt);
+    ret = SQLBindCol(m_hstmt, 1, SQL_C_SLONG, delays.data(), 0,
+                     delay_ind.data());
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLBindCol(m_hstmt, 2, SQL_C_DOUBLE, distances.data(), 0,
+                     distance_ind.data());
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+    ret = SQLFetch(m_hstmt);
+    LogAnyDiagnostics(SQL_HANDLE_STMT, m_hstmt, ret);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    ASSERT_EQ(rows_fetched, multi_row_cnt);
+    CloseCursor(&m_hstmt, true, true);
+
+    // Fetch the same rows one at a time and compare with the arrays
+    SQLINTEGER delay = 0;
+    SQLDOUBLE distance = 0;
+    SQLLEN ind = 0;
+    ret = SQLSetStmtAttr(m_hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    ExecuteQuery(columns, flight_data_set, multi_row, &m_hstmt);
+    for (size_t i = 0; i < multi_row_cnt; i++) {
+        ret = SQLFetch(m_hstmt);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ret = SQLGetData(m_hstmt, 1, SQL_C_SLONG, &delay, 0, &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        EXPECT_EQ(ind, delay_ind[i]);
+        EXPECT_EQ(delay, delays[i]);
+        ret = SQLGetData(m_hstmt, 2, SQL_C_DOUBLE, &distance, 0, &ind);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        EXPECT_EQ(ind, distance_ind[i]);
+        EXPECT_DOUBLE_EQ(distance, distances[i]);
+    }
+    CloseCursor(&m_hstmt, true, true);
+}
+
 TEST_F(TestSQLGetData, GetWVARCHARData) {
     QueryFetch(single_col, flight_data_set, single_row, &m_hstmt);
 
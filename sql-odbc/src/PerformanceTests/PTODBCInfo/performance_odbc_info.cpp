@@ -14,8 +14,13 @@
 #include "rabbit.hpp"
 #include <codecvt>
 #include <locale>
+#include <numeric>
+#include <aws/core/utils/HashingUtils.h>
 // clang-format on
 
+#define WIDE_SCHEMA_FIELD_COUNT 3000
+#define ITERATION_COUNT 10
+
 const std::vector< std::string > base_items = {"name", "cluster_name",
                                                "cluster_uuid"};
 const std::vector< std::string > version_items = {
@@ -31,6 +36,7 @@ const std::vector< std::string > version_items = {
 const std::string sync_start = "%%__PARSE__SYNC__START__%%";
 const std::string sync_sep = "%%__SEP__%%";
 const std::string sync_end = "%%__PARSE__SYNC__END__%%";
+const std::string wide_schema_index = "odbc_wide_schema";
 
 std::string wstring_to_string(const std::wstring& src) {
     return std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t >{}
@@ -105,6 +111,103 @@ void ParseVersionInfoString(
     }
 }
 
+// Sends a JSON body to the wide schema index. IssueRequest only sends SQL
+// queries, so the request is built here. The caller keeps a connection alive
+// so the AWS SDK is initialized.
+void SendWideSchemaRequest(const Aws::Http::HttpMethod method,
+                           const std::string& body) {
+    Aws::Client::ClientConfiguration config;
+    config.verifySSL = rt_opts.crypt.verify_server;
+    std::shared_ptr< Aws::Http::HttpClient > client =
+        Aws::Http::CreateHttpClient(config);
+    std::shared_ptr< Aws::Http::HttpRequest > request =
+        Aws::Http::CreateHttpRequest(
+            Aws::String(rt_opts.conn.server + ":" + rt_opts.conn.port + "/"
+                        + wide_schema_index),
+            method, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    std::string userpw = rt_opts.auth.username + ":" + rt_opts.auth.password;
+    Aws::Utils::Array< unsigned char > userpw_arr(
+        reinterpret_cast< const unsigned char* >(userpw.c_str()),
+        userpw.length());
+    request->SetAuthorization(
+        "Basic " + Aws::Utils::HashingUtils::Base64Encode(userpw_arr));
+    if (!body.empty()) {
+        request->SetHeaderValue(Aws::Http::CONTENT_TYPE_HEADER,
+                                "application/json");
+        std::shared_ptr< Aws::StringStream > body_stream =
+            Aws::MakeShared< Aws::StringStream >("WideSchemaBody");
+        *body_stream << body;
+        request->AddContentBody(body_stream);
+        request->SetContentLength(std::to_string(body.size()));
+    }
+    client->MakeRequest(request);
+}
+
+// SQLColumns on an index with thousands of mapped fields, as produced by
+// flattened nested objects. Most of the time goes into matching the DESCRIBE
+// rows against the columns of the table.
+TEST(InfoCollect, WideSchemaColumns) {
+    OpenSearchCommunication opensearch_comm;
+    opensearch_comm.ConnectionOptions(rt_opts, false, 0, 0);
+    ASSERT_TRUE(opensearch_comm.ConnectDBStart());
+
+    std::string mapping =
+        "{\"settings\":{\"index.mapping.total_fields.limit\":"
+        + std::to_string(WIDE_SCHEMA_FIELD_COUNT + 1000)
+        + "},\"mappings\":{\"properties\":{";
+    for (size_t i = 0; i < WIDE_SCHEMA_FIELD_COUNT; i++) {
+        mapping += (i ? ",\"field_" : "\"field_") + std::to_string(i)
+                   + "\":{\"type\":\"keyword\"}";
+    }
+    mapping += "}}}";
+    SendWideSchemaRequest(Aws::Http::HttpMethod::HTTP_DELETE, "");
+    SendWideSchemaRequest(Aws::Http::HttpMethod::HTTP_PUT, mapping);
+
+    SQLHENV env = SQL_NULL_HENV;
+    SQLHDBC conn = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+    AllocStatement((SQLTCHAR*)conn_string.c_str(), &env, &conn, &hstmt, true,
+                   true);
+    const std::wstring table_name(wide_schema_index.begin(),
+                                  wide_schema_index.end());
+    std::vector< long long > times;
+    for (size_t iter = 0; iter < ITERATION_COUNT; iter++) {
+        auto start = std::chrono::steady_clock::now();
+        SQLRETURN ret = SQLColumns(hstmt, NULL, SQL_NTS, NULL, SQL_NTS,
+                                   (SQLTCHAR*)table_name.c_str(), SQL_NTS,
+                                   NULL, SQL_NTS);
+        size_t row_count = 0;
+        while (SQLFetch(hstmt) == SQL_SUCCESS)
+            row_count++;
+        auto end = std::chrono::steady_clock::now();
+        LogAnyDiagnostics(SQL_HANDLE_STMT, hstmt, ret);
+        EXPECT_TRUE(SQL_SUCCEEDED(ret));
+        EXPECT_EQ(static_cast< size_t >(WIDE_SCHEMA_FIELD_COUNT), row_count);
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        times.push_back(
+            std::chrono::duration_cast< std::chrono::milliseconds >(end - start)
+                .count());
+    }
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+    SQLDisconnect(conn);
+    SQLFreeHandle(SQL_HANDLE_ENV, env);
+    SendWideSchemaRequest(Aws::Http::HttpMethod::HTTP_DELETE, "");
+
+    std::sort(times.begin(), times.end());
+    long long time_mean =
+        std::accumulate(times.begin(), times.end(), 0ll) / times.size();
+    std::cout << sync_start << std::endl;
+    std::cout << "wide_schema_columns_fields" << sync_sep
+              << WIDE_SCHEMA_FIELD_COUNT << std::endl;
+    std::cout << "wide_schema_columns_min" << sync_sep << times.front()
+              << " ms" << std::endl;
+    std::cout << "wide_schema_columns_mean" << sync_sep << time_mean << " ms"
+              << std::endl;
+    std::cout << "wide_schema_columns_max" << sync_sep << times.back()
+              << " ms" << std::endl;
+    std::cout << sync_end << std::endl;
+}
+
 TEST(InfoCollect, EndPoint) {
     // Get version string from endpoint
     std::string version_info;
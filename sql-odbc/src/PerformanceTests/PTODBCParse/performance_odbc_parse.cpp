@@ -0,0 +1,516 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+// Times the stages a page of results goes through after it is received,
+// without a server: JSON pages are read from disk, parsed, copied into a
+// QResultClass, fetched through bound columns and converted. Pages are
+// generated in a few shapes, pages recorded from a server can be added with
+// -pages <dir>, where every .json file is a response of the JDBC format.
+// Cursor retrieval is timed end to end against the mock server.
+
+// clang-format off
+#include "pch.h"
+#include "unit_test_helper.h"
+#include "mock_opensearch_server.h"
+#include "opensearch_communication.h"
+#include "opensearch_helper.h"
+#include "opensearch_odbc.h"
+#include "opensearch_apifunc.h"
+#include "opensearch_connection.h"
+#include "opensearch_parse_result.h"
+#include "opensearch_response_parser.h"
+#include "convert.h"
+#include "qresult.h"
+#include "statement.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+// clang-format on
+
+#define ITERATION_COUNT 10
+#define BIND_SIZE 255
+#define CONVERT_SIZE 1024
+#define GENERATOR_SEED 1234
+#define MOCK_TOTAL_ROWS 200000
+#define MOCK_FETCH_SIZE "5000"
+#define MOCK_LATENCY_MS 5
+
+const std::string sync_start = "%%__PARSE__SYNC__START__%%";
+const std::string sync_sep = "%%__SEP__%%";
+const std::string sync_end = "%%__PARSE__SYNC__END__%%";
+const std::string pages_option = "-pages";
+const std::string generated_pages_dir = "opensearch_odbc_parse_pages";
+
+// Directory of recorded pages, empty if none were given
+std::string recorded_pages_dir;
+
+enum class ColumnKind { KEYWORD, TEXT, INTEGER, LONG, DOUBLE, BOOLEAN };
+
+typedef struct PageShape {
+    std::string name;
+    size_t rows;
+    std::vector< ColumnKind > columns;
+    double null_ratio;
+    size_t min_text;
+    size_t max_text;
+} PageShape;
+
+typedef struct Col {
+    SQLLEN data_len;
+    SQLCHAR data_dat[BIND_SIZE];
+} Col;
+
+std::vector< ColumnKind > CycleColumns(const std::vector< ColumnKind >& kinds,
+                                       size_t count) {
+    std::vector< ColumnKind > columns;
+    for (size_t i = 0; i < count; i++)
+        columns.push_back(kinds[i % kinds.size()]);
+    return columns;
+}
+
+const std::vector< ColumnKind > all_kinds = {
+    ColumnKind::KEYWORD, ColumnKind::INTEGER, ColumnKind::TEXT,
+    ColumnKind::DOUBLE,  ColumnKind::LONG,    ColumnKind::BOOLEAN};
+
+const std::vector< PageShape > page_shapes = {
+    {"wide", 250, CycleColumns(all_kinds, 400), 0.05, 4, 24},
+    {"long", 20000, CycleColumns(all_kinds, 6), 0.05, 4, 24},
+    {"numeric", 10000,
+     CycleColumns({ColumnKind::INTEGER, ColumnKind::LONG, ColumnKind::DOUBLE},
+                  16),
+     0.0, 0, 0},
+    {"string", 5000,
+     CycleColumns({ColumnKind::KEYWORD, ColumnKind::TEXT}, 8), 0.0, 16, 256},
+    {"null", 10000, CycleColumns(all_kinds, 24), 0.9, 4, 24}};
+
+const char* KindTypeName(ColumnKind kind) {
+    switch (kind) {
+        case ColumnKind::KEYWORD:
+            return "keyword";
+        case ColumnKind::TEXT:
+            return "text";
+        case ColumnKind::INTEGER:
+            return "integer";
+        case ColumnKind::LONG:
+            return "long";
+        case ColumnKind::DOUBLE:
+            return "double";
+        case ColumnKind::BOOLEAN:
+            return "boolean";
+    }
+    return "keyword";
+}
+
+// Builds a response the way the SQL plugin formats it. The seed is fixed so
+// every run times the same page.
+std::string GeneratePage(const PageShape& shape) {
+    std::mt19937 rng(GENERATOR_SEED);
+    std::uniform_real_distribution< double > unit(0.0, 1.0);
+    std::uniform_int_distribution< size_t > text_length(shape.min_text,
+                                                        shape.max_text);
+    std::uniform_int_distribution< int > letter('a', 'z');
+    std::uniform_int_distribution< int32_t > integer(INT32_MIN, INT32_MAX);
+    std::uniform_int_distribution< int64_t > long_integer(INT64_MIN,
+                                                          INT64_MAX);
+    std::uniform_real_distribution< double > real(-1e6, 1e6);
+
+    std::string page = "{\"schema\":[";
+    for (size_t col = 0; col < shape.columns.size(); col++) {
+        if (col != 0)
+            page += ",";
+        page += "{\"name\":\"column_" + std::to_string(col) + "\",\"type\":\""
+                + KindTypeName(shape.columns[col]) + "\"}";
+    }
+    page += "],\"datarows\":[";
+    char number[64];
+    for (size_t row = 0; row < shape.rows; row++) {
+        page += (row == 0) ? "[" : ",[";
+        for (size_t col = 0; col < shape.columns.size(); col++) {
+            if (col != 0)
+                page += ",";
+            if (unit(rng) < shape.null_ratio) {
+                page += "null";
+                continue;
+            }
+            switch (shape.columns[col]) {
+                case ColumnKind::KEYWORD:
+                case ColumnKind::TEXT: {
+                    page += "\"";
+                    for (size_t i = text_length(rng); i > 0; i--)
+                        page += static_cast< char >(letter(rng));
+                    page += "\"";
+                    break;
+                }
+                case ColumnKind::INTEGER:
+                    page += std::to_string(integer(rng));
+                    break;
+                case ColumnKind::LONG:
+                    page += std::to_string(long_integer(rng));
+                    break;
+                case ColumnKind::DOUBLE:
+                    snprintf(number, sizeof(number), "%.6f", real(rng));
+                    page += number;
+                    break;
+                case ColumnKind::BOOLEAN:
+                    page += (rng() & 1) ? "true" : "false";
+                    break;
+            }
+        }
+        page += "]";
+    }
+    page += "],\"total\":" + std::to_string(shape.rows)
+            + ",\"size\":" + std::to_string(shape.rows) + ",\"status\":200}";
+    return page;
+}
+
+std::string ReadPage(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream page;
+    page << in.rdbuf();
+    return page.str();
+}
+
+// Generated pages are written out and read back so they are loaded the same
+// way as recorded ones
+std::string LoadGeneratedPage(const PageShape& shape) {
+    std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / generated_pages_dir;
+    std::filesystem::create_directories(dir);
+    std::filesystem::path path = dir / (shape.name + ".json");
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << GeneratePage(shape);
+    }
+    return ReadPage(path);
+}
+
+// Mirrors what OpenSearchCommunication does once a response arrives
+void ParsePage(OpenSearchResult& result) {
+    ParseQueryResponse(result);
+    for (auto& it : result.schema) {
+        ColumnInfo col_info;
+        col_info.field_name = it.first;
+        col_info.type_oid = KEYWORD_TYPE_OID;
+        col_info.type_size = KEYWORD_TYPE_SIZE;
+        col_info.display_size = KEYWORD_DISPLAY_SIZE;
+        col_info.length_of_str = KEYWORD_TYPE_SIZE;
+        col_info.relation_id = 0;
+        col_info.attribute_number = 0;
+        result.column_info.push_back(col_info);
+    }
+    result.command_type = "SELECT";
+    result.num_fields = (uint16_t)result.schema.size();
+}
+
+SQLSMALLINT TargetType(OID type) {
+    switch (type) {
+        case OPENSEARCH_TYPE_BOOL:
+            return SQL_C_BIT;
+        case OPENSEARCH_TYPE_INT2:
+        case OPENSEARCH_TYPE_INT4:
+            return SQL_C_SLONG;
+        case OPENSEARCH_TYPE_INT8:
+            return SQL_C_SBIGINT;
+        case OPENSEARCH_TYPE_FLOAT4:
+        case OPENSEARCH_TYPE_FLOAT8:
+            return SQL_C_DOUBLE;
+        default:
+            return SQL_C_CHAR;
+    }
+}
+
+// Runs the stage ITERATION_COUNT times and returns the median time in
+// seconds. Setup and teardown are not timed.
+double MedianSeconds(const std::function< void() >& setup,
+                     const std::function< void() >& stage,
+                     const std::function< void() >& teardown) {
+    std::vector< double > times;
+    for (size_t i = 0; i < ITERATION_COUNT; i++) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        stage();
+        auto end = std::chrono::steady_clock::now();
+        teardown();
+        times.push_back(std::chrono::duration< double >(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+void PrintThroughput(const std::string& name, double seconds, size_t rows,
+                     size_t bytes) {
+    std::cout << name << "_rows" << sync_sep
+              << static_cast< size_t >(rows / seconds) << " rows/s"
+              << std::endl;
+    std::cout << name << "_bytes" << sync_sep
+              << static_cast< size_t >(bytes / seconds) << " bytes/s"
+              << std::endl;
+}
+
+class TestParsePipeline : public testing::Test {
+   public:
+    TestParsePipeline() {
+    }
+    void SetUp() {
+        m_conn = CC_Constructor();
+        ASSERT_NE(m_conn, nullptr);
+    }
+    void TearDown() {
+        if (m_conn != NULL)
+            CC_Destructor(m_conn);
+    }
+
+   protected:
+    void RunPipeline(const std::string& name, const std::string& page);
+    QResultClass* BuildResult(OpenSearchResult& result);
+    StatementClass* BuildStatement(OpenSearchResult& result);
+
+    ConnectionClass* m_conn = NULL;
+};
+
+QResultClass* TestParsePipeline::BuildResult(OpenSearchResult& result) {
+    QResultClass* res = QR_Constructor();
+    if (res == NULL)
+        return NULL;
+    res->rstatus = PORES_COMMAND_OK;
+    if (!CC_from_OpenSearchResult(res, m_conn, NULL, result)) {
+        QR_Destructor(res);
+        return NULL;
+    }
+    return res;
+}
+
+// Sets the statement up the way an executed query leaves it
+StatementClass* TestParsePipeline::BuildStatement(OpenSearchResult& result) {
+    StatementClass* stmt = SC_Constructor(m_conn);
+    if (stmt == NULL)
+        return NULL;
+    SC_set_Result(stmt, BuildResult(result));
+    stmt->status = STMT_FINISHED;
+    stmt->currTuple = -1;
+    SC_set_rowset_start(stmt, -1, FALSE);
+    return stmt;
+}
+
+void TestParsePipeline::RunPipeline(const std::string& name,
+                                    const std::string& page) {
+    OpenSearchResult probe;
+    probe.result_json = page;
+    ASSERT_NO_THROW(ParsePage(probe));
+    const size_t rows = probe.num_rows;
+    const size_t bytes = page.size();
+
+    // Parse the response, the last parsed page feeds the other stages
+    std::unique_ptr< OpenSearchResult > result;
+    double parse_time = MedianSeconds(
+        [&]() {
+            result = std::make_unique< OpenSearchResult >();
+            result->result_json = page;
+        },
+        [&]() { ParsePage(*result); }, []() {});
+
+    // Copy the first page into a new result, with the column headers
+    QResultClass* res = NULL;
+    bool built = true;
+    double build_time = MedianSeconds(
+        [&]() {
+            res = QR_Constructor();
+            res->rstatus = PORES_COMMAND_OK;
+        },
+        [&]() {
+            built &= (CC_from_OpenSearchResult(res, m_conn, NULL, *result)
+                      == TRUE);
+        },
+        [&]() { QR_Destructor(res); });
+    EXPECT_TRUE(built);
+
+    // Append a cursor page to a result that already has its columns
+    bool appended = true;
+    double append_time = MedianSeconds(
+        [&]() {
+            res = QR_Constructor();
+            res->rstatus = PORES_COMMAND_OK;
+            CC_Metadata_from_OpenSearchResult(res, m_conn, NULL, *result);
+        },
+        [&]() {
+            appended &= (CC_Append_Table_Data(*result, res,
+                                              QR_NumResultCols(res),
+                                              *(res->fields))
+                         == TRUE);
+        },
+        [&]() { QR_Destructor(res); });
+    EXPECT_TRUE(appended);
+
+    // Fetch every row into columns bound as SQL_C_CHAR
+    StatementClass* stmt = NULL;
+    std::vector< Col > cols(result->num_fields);
+    size_t fetched = 0;
+    double fetch_time = MedianSeconds(
+        [&]() {
+            stmt = BuildStatement(*result);
+            for (size_t i = 0; i < cols.size(); i++)
+                OPENSEARCHAPI_BindCol(stmt, (SQLUSMALLINT)(i + 1), SQL_C_CHAR,
+                                      cols[i].data_dat, BIND_SIZE,
+                                      &cols[i].data_len);
+        },
+        [&]() {
+            fetched = 0;
+            while (SQL_SUCCEEDED(OPENSEARCHAPI_Fetch(stmt)))
+                fetched++;
+        },
+        [&]() { SC_Destructor(stmt); });
+    EXPECT_EQ(rows, fetched);
+
+    // Convert every cell to the C type matching its column
+    size_t failed = 0;
+    double convert_time = MedianSeconds(
+        [&]() { stmt = BuildStatement(*result); },
+        [&]() {
+            QResultClass* q_res = SC_get_Result(stmt);
+            const int num_cols = QR_NumResultCols(q_res);
+            char buffer[CONVERT_SIZE];
+            SQLLEN used = 0, indicator = 0;
+            failed = 0;
+            SC_set_current_col(stmt, -1);
+            for (SQLULEN row = 0; row < q_res->num_cached_rows; row++) {
+                TupleField* tuple = q_res->backend_tuples + row * num_cols;
+                for (int col = 0; col < num_cols; col++) {
+                    OID type = QR_get_field_type(q_res, col);
+                    int ret = copy_and_convert_field(
+                        stmt, type, QR_get_atttypmod(q_res, col), &tuple[col],
+                        TargetType(type), 0, buffer, sizeof(buffer), &used,
+                        &indicator);
+                    if (ret != COPY_OK)
+                        failed++;
+                }
+            }
+        },
+        [&]() { SC_Destructor(stmt); });
+    EXPECT_EQ((size_t)0, failed);
+
+    std::cout << sync_start << std::endl;
+    std::cout << name << "_page" << sync_sep << rows << " rows, "
+              << result->num_fields << " columns, " << bytes << " bytes"
+              << std::endl;
+    // Throughput is measured against the size of the page as received for
+    // every stage, so the stages can be compared with each other
+    PrintThroughput(name + "_parse", parse_time, rows, bytes);
+    PrintThroughput(name + "_build", build_time, rows, bytes);
+    PrintThroughput(name + "_append", append_time, rows, bytes);
+    PrintThroughput(name + "_fetch", fetch_time, rows, bytes);
+    PrintThroughput(name + "_convert", convert_time, rows, bytes);
+    std::cout << sync_end << std::endl;
+}
+
+const PageShape& GetShape(const std::string& name) {
+    return *std::find_if(
+        page_shapes.begin(), page_shapes.end(),
+        [&](const PageShape& shape) { return shape.name == name; });
+}
+
+TEST_F(TestParsePipeline, WidePage) {
+    RunPipeline("wide", LoadGeneratedPage(GetShape("wide")));
+}
+
+TEST_F(TestParsePipeline, LongPage) {
+    RunPipeline("long", LoadGeneratedPage(GetShape("long")));
+}
+
+TEST_F(TestParsePipeline, NumericPage) {
+    RunPipeline("numeric", LoadGeneratedPage(GetShape("numeric")));
+}
+
+TEST_F(TestParsePipeline, StringPage) {
+    RunPipeline("string", LoadGeneratedPage(GetShape("string")));
+}
+
+TEST_F(TestParsePipeline, NullPage) {
+    RunPipeline("null", LoadGeneratedPage(GetShape("null")));
+}
+
+TEST_F(TestParsePipeline, RecordedPages) {
+    if (recorded_pages_dir.empty())
+        return;
+    for (auto& entry :
+         std::filesystem::directory_iterator(recorded_pages_dir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json")
+            RunPipeline("recorded_" + entry.path().stem().string(),
+                        ReadPage(entry.path()));
+    }
+}
+
+// Pages are requested over loopback HTTP with a fixed latency per page, so
+// the time spent waiting in PopResult shows how well prefetching hides it
+TEST(TestMockServerThroughput, CursorRetrieval) {
+    mock_server_config config;
+    config.total_rows = MOCK_TOTAL_ROWS;
+    config.latency = std::chrono::milliseconds(MOCK_LATENCY_MS);
+    MockOpenSearchServer server(config);
+    ASSERT_TRUE(server.Start());
+
+    runtime_options opts = {{server.GetHost(), server.GetPort(), "10", "0"},
+                            {"NONE", "", "", "us-west-3"},
+                            {false, false, "", "", "", ""}};
+    OpenSearchCommunication conn;
+    ASSERT_TRUE(conn.ConnectionOptions(opts, false, 0, 0));
+    ASSERT_TRUE(conn.ConnectDBStart());
+
+    size_t rows = 0;
+    prefetch_metrics metrics;
+    mock_server_metrics before = server.GetMetrics();
+    double time = MedianSeconds(
+        []() {},
+        [&]() {
+            rows = 0;
+            ASSERT_EQ(0, conn.ExecDirect("SELECT * FROM mock_index",
+                                         MOCK_FETCH_SIZE));
+            OpenSearchResult* result = NULL;
+            while ((result = conn.PopResult()) != NULL) {
+                rows += result->num_rows;
+                OpenSearchClearResult(result);
+            }
+            metrics = conn.GetPrefetchMetrics();
+        },
+        []() {});
+    EXPECT_EQ((size_t)MOCK_TOTAL_ROWS, rows);
+    const size_t bytes =
+        (server.GetMetrics().bytes_sent - before.bytes_sent) / ITERATION_COUNT;
+
+    std::cout << sync_start << std::endl;
+    std::cout << "mock_cursor_page" << sync_sep << MOCK_FETCH_SIZE
+              << " rows, " << MOCK_LATENCY_MS << " ms latency" << std::endl;
+    PrintThroughput("mock_cursor", time, rows, bytes);
+    std::cout << "mock_cursor_stalls" << sync_sep << metrics.pop_stalls
+              << " of " << metrics.pages_popped << " pages, "
+              << metrics.stall_time_us / 1000 << " ms" << std::endl;
+    std::cout << sync_end << std::endl;
+}
+
+int main(int argc, char** argv) {
+    testing::internal::CaptureStdout();
+    ::testing::InitGoogleTest(&argc, argv);
+
+    char** pages = std::find(argv, argv + argc, pages_option);
+    if (pages != argv + argc && ++pages != argv + argc)
+        recorded_pages_dir = *pages;
+
+    int failures = RUN_ALL_TESTS();
+
+    std::string output = testing::internal::GetCapturedStdout();
+    std::cout << output << std::endl;
+    std::cout << (failures ? "Not all tests passed." : "All tests passed")
+              << std::endl;
+    WriteFileIfSpecified(argv, argv + argc, "-fout", output);
+
+    return failures;
+}
@@ -19,6 +19,7 @@ IT_TYPE = "IT"
 PERFORMANCE_TYPE = "performance"
 PERFORMANCE_INFO = "performance_info"
 PERFORMANCE_RESULTS = "performance_results"
+PERFORMANCE_PARSE = "performance_parse"
 EXCLUDE_EXTENSION_LIST = (
     ".py", ".c", ".cmake", ".log", 
     ".pdb", ".dll", ".sln", ".vcxproj", ".user",
@@ -247,6 +248,8 @@ def RunAllTests(test_types, test_suites, exclude_test_list):
                     final_output[PERFORMANCE_TYPE]["Info"] = GetAndTranslatePerformanceInfo(test)
                 elif test.replace(".exe", "").endswith(PERFORMANCE_RESULTS):
                     final_output[PERFORMANCE_TYPE]["Results"] = GetAndTranslatePerformanceResults(test)
+                elif test.replace(".exe", "").endswith(PERFORMANCE_PARSE):
+                    final_output[PERFORMANCE_TYPE]["Parse"] = GetAndTranslatePerformanceInfo(test)
         else:
             test_outputs = RunTests(tests, _type)
             final_output[_type] = TranslateTestOutput(_type, test_outputs)
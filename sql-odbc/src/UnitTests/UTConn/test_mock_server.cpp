@@ -0,0 +1,498 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+// clang-format off
+#include "pch.h"
+#include "unit_test_helper.h"
+#include "mock_opensearch_server.h"
+#include "opensearch_communication.h"
+#include "opensearch_helper.h"
+// clang-format on
+
+const std::string mock_query = "SELECT * FROM mock_index";
+const size_t mock_total_rows = 2500;
+const std::string mock_fetch_size = "1000";
+const size_t mock_page_count = 3;
+
+class TestMockServerExecution : public testing::Test {
+   public:
+    TestMockServerExecution() {
+    }
+    void SetUp() {
+        ASSERT_TRUE(m_server.Start());
+        m_config.total_rows = mock_total_rows;
+        m_server.SetConfig(m_config);
+    }
+    void TearDown() {
+        m_server.Stop();
+    }
+
+   protected:
+    runtime_options GetOptions() {
+        return {{m_server.GetHost(), m_server.GetPort(), "5", "0"},
+                {"NONE", "", "", "us-west-3"},
+                {false, false, "", "", "", ""}};
+    }
+
+    void Connect(OpenSearchCommunication& conn,
+                 const std::string& response_format = "",
+                 bool compression = false) {
+        runtime_options opts = GetOptions();
+        opts.conn.response_format = response_format;
+        opts.conn.compression = compression;
+        Connect(conn, opts);
+    }
+
+    void Connect(OpenSearchCommunication& conn, runtime_options& opts) {
+        ASSERT_TRUE(conn.ConnectionOptions(opts, false, 0, 0));
+        ASSERT_TRUE(conn.ConnectDBStart());
+    }
+
+    // Pops the pages of the query, returns the number of rows
+    size_t PopAllRows(OpenSearchCommunication& conn, size_t& pages) {
+        size_t rows = 0;
+        pages = 0;
+        OpenSearchResult* result = NULL;
+        while ((result = conn.PopResult()) != NULL) {
+            rows += result->num_rows;
+            pages++;
+            OpenSearchClearResult(result);
+        }
+        return rows;
+    }
+
+    MockOpenSearchServer m_server;
+    mock_server_config m_config;
+};
+
+TEST_F(TestMockServerExecution, CursorPagesAreFetched) {
+    OpenSearchCommunication conn;
+    Connect(conn);
+    mock_server_metrics before = m_server.GetMetrics();
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    size_t pages = 0;
+    EXPECT_EQ(mock_total_rows, PopAllRows(conn, pages));
+    EXPECT_EQ(mock_page_count, pages);
+
+    mock_server_metrics after = m_server.GetMetrics();
+    EXPECT_EQ((size_t)1, after.query_requests - before.query_requests);
+    EXPECT_EQ(mock_page_count - 1,
+              after.cursor_requests - before.cursor_requests);
+    EXPECT_EQ((size_t)1, after.close_requests - before.close_requests);
+    EXPECT_EQ(pages, conn.GetPrefetchMetrics().pages_popped);
+}
+
+TEST_F(TestMockServerExecution, NoFetchSizeReturnsSinglePage) {
+    OpenSearchCommunication conn;
+    Connect(conn);
+    mock_server_metrics before = m_server.GetMetrics();
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), "0"));
+    size_t pages = 0;
+    EXPECT_EQ(m_config.default_size, PopAllRows(conn, pages));
+    EXPECT_EQ((size_t)1, pages);
+    EXPECT_EQ(before.cursor_requests, m_server.GetMetrics().cursor_requests);
+}
+
+TEST_F(TestMockServerExecution, NullValuesAreParsed) {
+    m_config.null_interval = 2;
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn);
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    size_t null_cells = 0;
+    OpenSearchResult* result = NULL;
+    while ((result = conn.PopResult()) != NULL) {
+        for (auto& cell : result->datarows) {
+            if (cell.length < 0)
+                null_cells++;
+        }
+        OpenSearchClearResult(result);
+    }
+    EXPECT_EQ(mock_total_rows / 2 * m_config.schema.size(), null_cells);
+}
+
+TEST_F(TestMockServerExecution, StopRetrievalClosesCursor) {
+    m_config.total_rows = 100000;
+    m_config.latency = std::chrono::milliseconds(20);
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn);
+    mock_server_metrics before = m_server.GetMetrics();
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), "100"));
+    OpenSearchResult* result = conn.PopResult();
+    ASSERT_NE(nullptr, result);
+    OpenSearchClearResult(result);
+    conn.StopResultRetrieval();
+
+    mock_server_metrics after = m_server.GetMetrics();
+    EXPECT_EQ((size_t)1, after.close_requests - before.close_requests);
+    EXPECT_LT(after.rows_sent - before.rows_sent, m_config.total_rows);
+}
+
+TEST_F(TestMockServerExecution, QueryErrorIsReported) {
+    m_config.error_page = 1;
+    m_config.error_status = 400;
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn);
+
+    EXPECT_EQ(-1,
+              conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    EXPECT_NE(std::string::npos, conn.GetErrorMessage().find("Error on page 1"));
+    EXPECT_EQ(nullptr, conn.PopResult());
+}
+
+TEST_F(TestMockServerExecution, CursorErrorEndsResult) {
+    m_config.error_page = 2;
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn);
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    size_t pages = 0;
+    EXPECT_EQ((size_t)std::stoul(mock_fetch_size), PopAllRows(conn, pages));
+    EXPECT_EQ((size_t)1, pages);
+    EXPECT_FALSE(conn.GetErrorMessage().empty());
+}
+
+TEST_F(TestMockServerExecution, CursorErrorIsKeptOnItsStream) {
+    m_config.error_page = 2;
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn);
+    OpenSearchResultStream failing;
+    OpenSearchResultStream other;
+
+    ASSERT_EQ(0, conn.ExecDirect(failing, mock_query.c_str(),
+                                 mock_fetch_size.c_str()));
+    ASSERT_EQ(0, conn.ExecDirect(other, mock_query.c_str(), "0"));
+    OpenSearchResult* result = NULL;
+    while ((result = failing.PopResult()) != NULL) {
+        OpenSearchClearResult(result);
+    }
+    while ((result = other.PopResult()) != NULL) {
+        OpenSearchClearResult(result);
+    }
+
+    EXPECT_NE(std::string::npos, failing.GetErrorMessage().find("Cursor error"));
+    EXPECT_TRUE(other.GetErrorMessage().empty());
+    EXPECT_EQ(std::string::npos, conn.GetErrorMessage().find("Cursor error"));
+
+    // The next query on the stream starts without the error
+    ASSERT_EQ(0, conn.ExecDirect(failing, mock_query.c_str(), "0"));
+    EXPECT_TRUE(failing.GetErrorMessage().empty());
+}
+
+TEST_F(TestMockServerExecution, StreamsRunQueriesAtOnce) {
+    m_config.latency = std::chrono::milliseconds(20);
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn);
+    OpenSearchResultStream failing;
+    OpenSearchResultStream other;
+
+    // A query failing on one stream while the other one is sent
+    int other_ret = -1;
+    std::thread other_query([&]() {
+        other_ret = conn.ExecDirect(other, mock_query.c_str(), "0");
+    });
+    EXPECT_EQ(-1, conn.ExecDirect(failing, NULL, "0"));
+    other_query.join();
+
+    ASSERT_EQ(0, other_ret);
+    EXPECT_NE(std::string::npos,
+              failing.GetErrorMessage().find("Query is NULL"));
+    EXPECT_TRUE(other.GetErrorMessage().empty());
+    OpenSearchResult* result = other.PopResult();
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(m_config.default_size, result->num_rows);
+    OpenSearchClearResult(result);
+}
+
+TEST_F(TestMockServerExecution, QueryMetricsAreCounted) {
+    OpenSearchCommunication conn;
+    Connect(conn);
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    size_t pages = 0;
+    EXPECT_EQ(mock_total_rows, PopAllRows(conn, pages));
+
+    query_metrics metrics = conn.GetQueryMetrics();
+    EXPECT_EQ(mock_page_count, metrics.pages_fetched);
+    EXPECT_GT(metrics.bytes_received, (uint64_t)0);
+    EXPECT_GT(metrics.http_time_us, (uint64_t)0);
+
+    // The counters start over with the next query
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), "0"));
+    EXPECT_EQ(m_config.default_size, PopAllRows(conn, pages));
+    EXPECT_EQ((size_t)1, conn.GetQueryMetrics().pages_fetched);
+}
+
+TEST_F(TestMockServerExecution, StreamsPageIndependently) {
+    OpenSearchCommunication conn;
+    Connect(conn);
+    OpenSearchResultStream first;
+    OpenSearchResultStream second;
+    mock_server_metrics before = m_server.GetMetrics();
+
+    ASSERT_EQ(0, conn.ExecDirect(first, mock_query.c_str(),
+                                 mock_fetch_size.c_str()));
+    ASSERT_EQ(0, conn.ExecDirect(second, mock_query.c_str(),
+                                 mock_fetch_size.c_str()));
+
+    // Starting the second query leaves the pages of the first one alone
+    size_t first_rows = 0;
+    size_t second_rows = 0;
+    OpenSearchResult* first_page = NULL;
+    OpenSearchResult* second_page = NULL;
+    do {
+        first_page = first.PopResult();
+        if (first_page != NULL) {
+            first_rows += first_page->num_rows;
+            OpenSearchClearResult(first_page);
+        }
+        second_page = second.PopResult();
+        if (second_page != NULL) {
+            second_rows += second_page->num_rows;
+            OpenSearchClearResult(second_page);
+        }
+    } while (first_page != NULL || second_page != NULL);
+
+    EXPECT_EQ(mock_total_rows, first_rows);
+    EXPECT_EQ(mock_total_rows, second_rows);
+    EXPECT_EQ(mock_page_count, first.GetQueryMetrics().pages_fetched);
+    EXPECT_EQ(mock_page_count, second.GetQueryMetrics().pages_fetched);
+    mock_server_metrics after = m_server.GetMetrics();
+    EXPECT_EQ((size_t)2, after.query_requests - before.query_requests);
+    EXPECT_EQ((size_t)2, after.close_requests - before.close_requests);
+}
+
+TEST_F(TestMockServerExecution, ClosedPrefetchedCursorIsDropped) {
+    OpenSearchCommunication conn;
+    Connect(conn);
+    OpenSearchResultStream stream;
+
+    // Two pages, the second is prefetched and ends the retrieval
+    ASSERT_EQ(0, conn.ExecDirect(stream, mock_query.c_str(), "1500"));
+    while (stream.GetQueryMetrics().pages_fetched < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stream.StopRetrieval();
+
+    // The statement runs its next query without popping the old pages
+    ASSERT_EQ(0, conn.ExecDirect(stream, mock_query.c_str(), "0"));
+    OpenSearchResult* result = stream.PopResult();
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(m_config.default_size, result->num_rows);
+    OpenSearchClearResult(result);
+    EXPECT_EQ(nullptr, stream.PopResult());
+}
+
+TEST_F(TestMockServerExecution, StoppedStreamLeavesOthersRunning) {
+    m_config.latency = std::chrono::milliseconds(5);
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn);
+    OpenSearchResultStream first;
+    OpenSearchResultStream second;
+
+    ASSERT_EQ(0, conn.ExecDirect(first, mock_query.c_str(), "100"));
+    ASSERT_EQ(0, conn.ExecDirect(second, mock_query.c_str(), "100"));
+    OpenSearchResult* result = first.PopResult();
+    ASSERT_NE(nullptr, result);
+    OpenSearchClearResult(result);
+    first.StopRetrieval();
+    EXPECT_EQ(nullptr, first.PopResult());
+
+    size_t rows = 0;
+    while ((result = second.PopResult()) != NULL) {
+        rows += result->num_rows;
+        OpenSearchClearResult(result);
+    }
+    EXPECT_EQ(mock_total_rows, rows);
+}
+
+TEST_F(TestMockServerExecution, ConnectionsShareIoThreads) {
+    m_config.latency = std::chrono::milliseconds(5);
+    m_server.SetConfig(m_config);
+    const size_t connection_count = 4;
+    const size_t streams_per_connection = 4;
+    std::vector< std::unique_ptr< OpenSearchCommunication > > conns;
+    std::vector< std::unique_ptr< OpenSearchResultStream > > streams;
+    for (size_t i = 0; i < connection_count; i++) {
+        conns.push_back(std::make_unique< OpenSearchCommunication >());
+        Connect(*conns.back());
+        for (size_t j = 0; j < streams_per_connection; j++) {
+            streams.push_back(std::make_unique< OpenSearchResultStream >());
+            ASSERT_EQ(0, conns.back()->ExecDirect(*streams.back(),
+                                                  mock_query.c_str(), "100"));
+        }
+    }
+
+    // Every stream is read by its own thread, their pages are all fetched
+    // by the I/O threads of the driver
+    std::vector< size_t > rows(streams.size(), 0);
+    std::vector< std::thread > readers;
+    for (size_t i = 0; i < streams.size(); i++) {
+        readers.emplace_back([&, i]() {
+            OpenSearchResult* result = NULL;
+            while ((result = streams[i]->PopResult()) != NULL) {
+                rows[i] += result->num_rows;
+                OpenSearchClearResult(result);
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (size_t i = 0; i < streams.size(); i++) {
+        EXPECT_EQ(mock_total_rows, rows[i]);
+    }
+}
+
+TEST_F(TestMockServerExecution, FlatFormatsAreDecoded) {
+    m_config.null_interval = 2;
+    m_server.SetConfig(m_config);
+    for (const std::string format : {"csv", "raw"}) {
+        OpenSearchCommunication conn;
+        Connect(conn, format);
+        mock_server_metrics before = m_server.GetMetrics();
+
+        ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), "0"));
+        OpenSearchResult* result = conn.PopResult();
+        ASSERT_NE(nullptr, result);
+        EXPECT_EQ(m_config.default_size, result->num_rows);
+        ASSERT_EQ(m_config.schema.size(), result->row_width);
+        // The cells are typed by the schema of the probe
+        const DataCell* row = &result->datarows[0];
+        EXPECT_EQ("value_0_0",
+                  std::string(result->CellText(row[0]), row[0].length));
+        EXPECT_EQ(CellType::INTEGER, row[1].type);
+        EXPECT_EQ(CellType::DOUBLE, row[2].type);
+        EXPECT_EQ(0.25, row[2].number);
+        EXPECT_EQ(CellType::BOOL, row[3].type);
+        EXPECT_EQ(1, row[3].integer);
+        row = &result->datarows[result->row_width];
+        for (size_t col = 0; col < result->row_width; col++) {
+            EXPECT_EQ(-1, row[col].length);
+        }
+        OpenSearchClearResult(result);
+        EXPECT_EQ(nullptr, conn.PopResult());
+
+        mock_server_metrics after = m_server.GetMetrics();
+        EXPECT_EQ((size_t)1, after.flat_requests - before.flat_requests);
+    }
+}
+
+TEST_F(TestMockServerExecution, DescribedSchemaFollowsMetadataCache) {
+    OpenSearchCommunication conn;
+    runtime_options opts = GetOptions();
+    opts.conn.metadata_cache_ttl = "60";
+    Connect(conn, opts);
+    OpenSearchResultStream stream;
+    const size_t width = m_config.schema.size();
+
+    OpenSearchResult* result = conn.DescribeQuery(stream, mock_query.c_str());
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(width, result->row_width);
+    OpenSearchClearResult(result);
+
+    // A mapping change is not seen within the TTL
+    m_config.schema.push_back({"new_column", "keyword"});
+    m_server.SetConfig(m_config);
+    mock_server_metrics before = m_server.GetMetrics();
+    result = conn.DescribeQuery(stream, mock_query.c_str());
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(width, result->row_width);
+    OpenSearchClearResult(result);
+    EXPECT_EQ(before.query_requests, m_server.GetMetrics().query_requests);
+
+    // Until the metadata cache is cleared
+    conn.ClearCatalogCache();
+    result = conn.DescribeQuery(stream, mock_query.c_str());
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(width + 1, result->row_width);
+    OpenSearchClearResult(result);
+}
+
+TEST_F(TestMockServerExecution, FlatFormatKeepsJdbcForPagesAndObjects) {
+    OpenSearchCommunication conn;
+    Connect(conn, "raw");
+    mock_server_metrics before = m_server.GetMetrics();
+
+    // The server does not page the flat formats
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    size_t pages = 0;
+    EXPECT_EQ(mock_total_rows, PopAllRows(conn, pages));
+    EXPECT_EQ(mock_page_count, pages);
+
+    // Nor does it print objects the way the JDBC format does
+    m_config.schema.push_back({"object_column", "object"});
+    m_server.SetConfig(m_config);
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), "0"));
+    EXPECT_EQ(m_config.default_size, PopAllRows(conn, pages));
+
+    mock_server_metrics after = m_server.GetMetrics();
+    EXPECT_EQ(before.flat_requests, after.flat_requests);
+}
+
+#ifdef HAVE_ZLIB
+TEST_F(TestMockServerExecution, CompressedPagesAreInflated) {
+    m_config.null_interval = 3;
+    m_server.SetConfig(m_config);
+    OpenSearchCommunication conn;
+    Connect(conn, "", true);
+    mock_server_metrics before = m_server.GetMetrics();
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    OpenSearchResult* result = conn.PopResult();
+    ASSERT_NE(nullptr, result);
+    const DataCell* row = &result->datarows[0];
+    EXPECT_EQ("value_0_0",
+              std::string(result->CellText(row[0]), row[0].length));
+    size_t rows = result->num_rows;
+    OpenSearchClearResult(result);
+    size_t pages = 0;
+    rows += PopAllRows(conn, pages);
+    EXPECT_EQ(mock_total_rows, rows);
+    EXPECT_EQ(mock_page_count, pages + 1);
+
+    // The bytes received are counted once inflated
+    mock_server_metrics after = m_server.GetMetrics();
+    EXPECT_EQ(mock_page_count,
+              after.compressed_responses - before.compressed_responses);
+    EXPECT_LT(after.bytes_sent - before.bytes_sent,
+              conn.GetQueryMetrics().bytes_received);
+}
+#endif  // HAVE_ZLIB
+
+TEST_F(TestMockServerExecution, BasicAuthorizationIsBuiltOnce) {
+    OpenSearchCommunication conn;
+    runtime_options opts = GetOptions();
+    opts.auth.auth_type = "BASIC";
+    opts.auth.username = "user";
+    opts.auth.password = "pass";
+    Connect(conn, opts);
+    mock_server_metrics before = m_server.GetMetrics();
+
+    ASSERT_EQ(0, conn.ExecDirect(mock_query.c_str(), mock_fetch_size.c_str()));
+    size_t pages = 0;
+    EXPECT_EQ(mock_total_rows, PopAllRows(conn, pages));
+
+    // Every page carries the header of the connection, setting it is a small
+    // part of the request time
+    mock_server_metrics after = m_server.GetMetrics();
+    EXPECT_EQ(mock_page_count,
+              after.authorized_requests - before.authorized_requests);
+    EXPECT_EQ("Basic dXNlcjpwYXNz", after.last_authorization);
+    query_metrics metrics = conn.GetQueryMetrics();
+    EXPECT_LT(metrics.sign_time_us, metrics.http_time_us);
+}
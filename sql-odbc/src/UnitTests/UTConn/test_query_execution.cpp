@@ -9,6 +9,7 @@
 #include "unit_test_helper.h"
 #include "opensearch_communication.h"
 #include "opensearch_helper.h"
+#include "opensearch_result_cache.h"
 // clang-format on
 
 const std::string valid_host = (use_ssl ? "https://localhost" : "localhost");
@@ -108,14 +109,82 @@ TEST(TestConnPopResult, PopTwoQueryResults) {
     ASSERT_TRUE(conn.ConnectionOptions(valid_conn_opt_val, false, 0, 0));
     ASSERT_TRUE(conn.ConnectDBStart());
 
-    conn.ExecDirect(some_columns_flights_query.c_str(), fetch_size.c_str());
-    conn.ExecDirect(all_columns_flights_query.c_str(), fetch_size.c_str());
+    // A new query drops the pages left in its stream, results of two queries
+    // are kept apart by running them on two streams
+    OpenSearchResultStream some_columns_stream;
+    OpenSearchResultStream all_columns_stream;
+    conn.ExecDirect(some_columns_stream, some_columns_flights_query.c_str(),
+                    fetch_size.c_str());
+    conn.ExecDirect(all_columns_stream, all_columns_flights_query.c_str(),
+                    fetch_size.c_str());
 
     // Pop some_columns
-    OpenSearchResult* result = conn.PopResult();
+    OpenSearchResult* result = some_columns_stream.PopResult();
+    ASSERT_NE(nullptr, result);
     EXPECT_EQ(some_columns_flights_count, result->num_fields);
+    OpenSearchClearResult(result);
 
     // Pop all_columns
-    result = conn.PopResult();
+    result = all_columns_stream.PopResult();
+    ASSERT_NE(nullptr, result);
     EXPECT_EQ(all_columns_flights_count, result->num_fields);
+    OpenSearchClearResult(result);
+}
+
+// Query result cache
+
+TEST(TestQueryResultCache, RepeatedQueryIsCached) {
+    runtime_options cached_opt_val = valid_conn_opt_val;
+    cached_opt_val.conn.query_cache_ttl = "60";
+    OpenSearchCommunication conn;
+    ASSERT_TRUE(conn.ConnectionOptions(cached_opt_val, false, 0, 0));
+    ASSERT_TRUE(conn.ConnectDBStart());
+    QueryResultCache().clear();
+
+    const query_cache_metrics before = conn.GetQueryCacheMetrics();
+    ASSERT_EQ(EXECUTION_SUCCESS,
+              conn.ExecDirect(query.c_str(), fetch_size.c_str()));
+    OpenSearchResult* fetched = conn.PopResult();
+    ASSERT_NE(nullptr, fetched);
+
+    // Whitespace differences do not matter
+    const std::string respaced = "  " + query + " ;";
+    ASSERT_EQ(EXECUTION_SUCCESS,
+              conn.ExecDirect(respaced.c_str(), fetch_size.c_str()));
+    OpenSearchResult* cached = conn.PopResult();
+    ASSERT_NE(nullptr, cached);
+    EXPECT_EQ(fetched->num_rows, cached->num_rows);
+    EXPECT_EQ(fetched->result_json, cached->result_json);
+
+    const query_cache_metrics after = conn.GetQueryCacheMetrics();
+    EXPECT_EQ(before.misses + 1, after.misses);
+    EXPECT_EQ(before.hits + 1, after.hits);
+    OpenSearchClearResult(fetched);
+    OpenSearchClearResult(cached);
+}
+
+TEST(TestQueryResultCache, LeastRecentlyUsedEvicted) {
+    OpenSearchResultCache cache;
+    auto pages = std::make_shared< OpenSearchResultCache::Pages >();
+    pages->push_back(std::make_shared< OpenSearchResult >());
+    const std::chrono::seconds ttl(60);
+
+    cache.put("a", pages, 10, 20);
+    cache.put("b", pages, 10, 20);
+    EXPECT_NE(nullptr, cache.get("a", ttl));
+    cache.put("c", pages, 10, 20);
+    EXPECT_EQ(nullptr, cache.get("b", ttl));
+    EXPECT_NE(nullptr, cache.get("a", ttl));
+    EXPECT_NE(nullptr, cache.get("c", ttl));
+
+    query_cache_metrics metrics = cache.metrics();
+    EXPECT_EQ((size_t)1, metrics.evictions);
+    EXPECT_EQ((size_t)2, metrics.entries);
+    EXPECT_EQ((size_t)20, metrics.bytes);
+}
+
+TEST(TestQueryResultCache, NormalizeStatement) {
+    EXPECT_EQ("SELECT a, b FROM t",
+              NormalizeStatement("\tSELECT  a,\n  b FROM t ; "));
+    EXPECT_EQ("SELECT 'a  b' FROM t", NormalizeStatement("SELECT 'a  b' FROM t"));
 }
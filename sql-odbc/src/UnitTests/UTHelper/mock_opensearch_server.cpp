@@ -0,0 +1,607 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "mock_opensearch_server.h"
+
+// clang-format off
+#ifdef WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include "rabbit.hpp"
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif  // HAVE_ZLIB
+// clang-format on
+
+#ifdef WIN32
+typedef SOCKET socket_type;
+#define CLOSE_SOCKET closesocket
+#define SHUTDOWN_BOTH SD_BOTH
+#else
+typedef int socket_type;
+#define INVALID_SOCKET (-1)
+#define CLOSE_SOCKET close
+#define SHUTDOWN_BOTH SHUT_RDWR
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+#define RECEIVE_BUFFER_SIZE 8192
+
+static const std::string LOOPBACK_HOST = "127.0.0.1";
+static const std::string CURSOR_PREFIX = "mock_cursor_";
+static const std::string PLUGIN_CHECK_QUERY = "SHOW TABLES";
+
+namespace {
+std::string ToLower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return (char)std::tolower(c); });
+    return str;
+}
+
+std::string Trim(const std::string& str) {
+    const size_t start = str.find_first_not_of(" \t\r");
+    if (start == std::string::npos)
+        return "";
+    return str.substr(start, str.find_last_not_of(" \t\r") - start + 1);
+}
+
+std::string Quote(const std::string& str) {
+    std::string quoted = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+std::string StatusText(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Internal Server Error";
+    }
+}
+
+std::string ErrorBody(const std::string& type, const std::string& reason,
+                      int status) {
+    return "{\"error\":{\"reason\":" + Quote(reason)
+           + ",\"details\":" + Quote("Returned by the mock server")
+           + ",\"type\":" + Quote(type)
+           + "},\"status\":" + std::to_string(status) + "}";
+}
+
+bool SendAll(socket_type sock, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int n = send(sock, data.data() + sent, (int)(data.size() - sent),
+                     SEND_FLAGS);
+        if (n <= 0)
+            return false;
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+// Value of a query parameter, empty if it is not there
+std::string GetParam(const std::string& params, const std::string& name) {
+    std::istringstream pairs(params);
+    std::string pair;
+    while (std::getline(pairs, pair, '&')) {
+        if (pair.compare(0, name.size() + 1, name + "=") == 0)
+            return ToLower(pair.substr(name.size() + 1));
+    }
+    return "";
+}
+
+// Turns a JSON value of GetValue into a cell of the csv and raw formats: null
+// is empty, strings lose their quotes and are quoted again if they hold the
+// separator
+std::string FlatValue(const std::string& json, char separator) {
+    if (json == "null")
+        return "";
+    if (json.empty() || json[0] != '"')
+        return json;
+    const std::string text = json.substr(1, json.size() - 2);
+    if (text.find(separator) == std::string::npos)
+        return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// Appends what is received to buffer, returns false once the peer is gone
+bool Receive(socket_type sock, std::string& buffer) {
+    char chunk[RECEIVE_BUFFER_SIZE];
+    int n = recv(sock, chunk, sizeof(chunk), 0);
+    if (n <= 0)
+        return false;
+    buffer.append(chunk, (size_t)n);
+    return true;
+}
+
+#ifdef HAVE_ZLIB
+// Body of a response sent with Content-Encoding: gzip
+std::string Gzip(const std::string& data) {
+    z_stream zstream = z_stream();
+    // 16 asks for a gzip header instead of a zlib one
+    deflateInit2(&zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                 Z_DEFAULT_STRATEGY);
+    std::string compressed(deflateBound(&zstream, (uLong)data.size()), '\0');
+    zstream.next_in = (Bytef*)data.data();
+    zstream.avail_in = (uInt)data.size();
+    zstream.next_out = (Bytef*)&compressed[0];
+    zstream.avail_out = (uInt)compressed.size();
+    deflate(&zstream, Z_FINISH);
+    compressed.resize(zstream.total_out);
+    deflateEnd(&zstream);
+    return compressed;
+}
+#endif  // HAVE_ZLIB
+}  // namespace
+
+MockOpenSearchServer::MockOpenSearchServer()
+    : m_running(false),
+      m_listen_socket((std::intptr_t)INVALID_SOCKET),
+      m_port(0) {
+}
+
+MockOpenSearchServer::MockOpenSearchServer(const mock_server_config& config)
+    : MockOpenSearchServer() {
+    m_config = config;
+}
+
+MockOpenSearchServer::~MockOpenSearchServer() {
+    Stop();
+}
+
+bool MockOpenSearchServer::Start() {
+    if (m_running)
+        return true;
+#ifdef WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+        return false;
+#endif
+
+    socket_type listen_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listen_socket == INVALID_SOCKET)
+        return false;
+
+    // Port 0 lets the system pick a free one
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t addr_len = sizeof(addr);
+    if (bind(listen_socket, (sockaddr*)&addr, sizeof(addr)) != 0
+        || listen(listen_socket, SOMAXCONN) != 0
+        || getsockname(listen_socket, (sockaddr*)&addr, &addr_len) != 0) {
+        CLOSE_SOCKET(listen_socket);
+        return false;
+    }
+
+    m_port = ntohs(addr.sin_port);
+    m_listen_socket = (std::intptr_t)listen_socket;
+    m_running = true;
+    m_accept_thread = std::thread([this]() { AcceptConnections(); });
+    return true;
+}
+
+void MockOpenSearchServer::Stop() {
+    if (!m_running.exchange(false))
+        return;
+
+    // accept does not return on every platform when the socket is closed,
+    // a connection wakes it up
+    socket_type wake_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (wake_socket != INVALID_SOCKET) {
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(m_port);
+        connect(wake_socket, (sockaddr*)&addr, sizeof(addr));
+        CLOSE_SOCKET(wake_socket);
+    }
+    m_accept_thread.join();
+    CLOSE_SOCKET((socket_type)m_listen_socket);
+    m_listen_socket = (std::intptr_t)INVALID_SOCKET;
+
+    // The connection threads close their own sockets once they see the
+    // shutdown
+    std::vector< std::thread > threads;
+    {
+        std::scoped_lock lock(m_mutex);
+        for (auto client : m_client_sockets)
+            shutdown((socket_type)client, SHUTDOWN_BOTH);
+        threads.swap(m_connection_threads);
+    }
+    for (auto& thread : threads)
+        thread.join();
+#ifdef WIN32
+    WSACleanup();
+#endif
+}
+
+std::string MockOpenSearchServer::GetHost() const {
+    return LOOPBACK_HOST;
+}
+
+std::string MockOpenSearchServer::GetPort() const {
+    return std::to_string(m_port);
+}
+
+void MockOpenSearchServer::SetConfig(const mock_server_config& config) {
+    std::scoped_lock lock(m_mutex);
+    m_config = config;
+}
+
+mock_server_metrics MockOpenSearchServer::GetMetrics() {
+    std::scoped_lock lock(m_mutex);
+    return m_metrics;
+}
+
+void MockOpenSearchServer::AcceptConnections() {
+    while (m_running) {
+        socket_type client =
+            accept((socket_type)m_listen_socket, NULL, NULL);
+        if (client == INVALID_SOCKET)
+            break;
+
+        std::scoped_lock lock(m_mutex);
+        if (!m_running) {
+            CLOSE_SOCKET(client);
+            break;
+        }
+        m_client_sockets.push_back((std::intptr_t)client);
+        m_connection_threads.emplace_back(
+            [this, client]() { ServeConnection((std::intptr_t)client); });
+    }
+}
+
+void MockOpenSearchServer::ServeConnection(std::intptr_t client) {
+    socket_type sock = (socket_type)client;
+    std::string buffer;
+    bool keep_alive = true;
+    while (keep_alive && m_running) {
+        // Request line and headers
+        size_t header_end;
+        bool connected = true;
+        while (connected
+               && (header_end = buffer.find("\r\n\r\n")) == std::string::npos)
+            connected = Receive(sock, buffer);
+        if (!connected)
+            break;
+        std::istringstream head(buffer.substr(0, header_end));
+        buffer.erase(0, header_end + 4);
+
+        std::string method, path, params, line;
+        head >> method >> path;
+        std::getline(head, line);
+        const size_t query_start = path.find('?');
+        if (query_start != std::string::npos) {
+            params = path.substr(query_start + 1);
+            path.resize(query_start);
+        }
+        size_t content_length = 0;
+        bool gzip = false;
+        std::string authorization;
+        while (std::getline(head, line)) {
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos)
+                continue;
+            const std::string name = ToLower(Trim(line.substr(0, colon)));
+            const std::string value = ToLower(Trim(line.substr(colon + 1)));
+            if (name == "content-length")
+                content_length = std::stoul(value);
+            else if (name == "expect" && value == "100-continue")
+                connected = SendAll(sock, "HTTP/1.1 100 Continue\r\n\r\n");
+            else if (name == "connection" && value == "close")
+                keep_alive = false;
+            else if (name == "accept-encoding")
+                gzip = value.find("gzip") != std::string::npos;
+            else if (name == "authorization")
+                authorization = Trim(line.substr(colon + 1));
+        }
+
+        while (connected && buffer.size() < content_length)
+            connected = Receive(sock, buffer);
+        if (!connected)
+            break;
+        const std::string body = buffer.substr(0, content_length);
+        buffer.erase(0, content_length);
+
+        std::string response;
+        const int status =
+            HandleRequest(method, path, params, body, response);
+        std::string encoding;
+#ifdef HAVE_ZLIB
+        if (gzip) {
+            response = Gzip(response);
+            encoding = "\r\nContent-Encoding: gzip";
+        }
+#else
+        (void)gzip;
+#endif  // HAVE_ZLIB
+        std::string message =
+            "HTTP/1.1 " + std::to_string(status) + " " + StatusText(status)
+            + "\r\nContent-Type: application/json; charset=UTF-8" + encoding
+            + "\r\nContent-Length: " + std::to_string(response.size())
+            + (keep_alive ? "" : "\r\nConnection: close") + "\r\n\r\n"
+            + response;
+        {
+            std::scoped_lock lock(m_mutex);
+            m_metrics.bytes_sent += response.size();
+            if (!encoding.empty())
+                m_metrics.compressed_responses++;
+            if (!authorization.empty()) {
+                m_metrics.authorized_requests++;
+                m_metrics.last_authorization = authorization;
+            }
+        }
+        if (!SendAll(sock, message))
+            break;
+    }
+
+    std::scoped_lock lock(m_mutex);
+    m_client_sockets.erase(std::remove(m_client_sockets.begin(),
+                                       m_client_sockets.end(), client),
+                           m_client_sockets.end());
+    CLOSE_SOCKET(sock);
+}
+
+bool MockOpenSearchServer::IsSqlEndpoint(const std::string& path) const {
+    return path == "/_plugins/_sql" || path == "/_opendistro/_sql";
+}
+
+int MockOpenSearchServer::HandleRequest(const std::string& method,
+                                        const std::string& path,
+                                        const std::string& params,
+                                        const std::string& body,
+                                        std::string& response) {
+    mock_server_config config;
+    {
+        std::scoped_lock lock(m_mutex);
+        config = m_config;
+    }
+
+    if (method == "GET" && (path == "/" || path.empty())) {
+        std::this_thread::sleep_for(config.latency);
+        {
+            std::scoped_lock lock(m_mutex);
+            m_metrics.info_requests++;
+        }
+        response = "{\"name\":\"mock-node\",\"cluster_name\":\"mock-cluster\","
+                   "\"cluster_uuid\":\"mock-uuid\",\"version\":{"
+                   "\"distribution\":"
+                   + Quote(config.distribution)
+                   + ",\"number\":" + Quote(config.version)
+                   + ",\"build_type\":\"tar\"},\"tagline\":\"The OpenSearch "
+                     "Project: https://opensearch.org/\"}";
+        return 200;
+    }
+
+    if (method == "POST" && path.size() > 6
+        && path.compare(path.size() - 6, 6, "/close") == 0
+        && IsSqlEndpoint(path.substr(0, path.size() - 6))) {
+        std::scoped_lock lock(m_mutex);
+        m_metrics.close_requests++;
+        response = "{\"succeeded\":true}";
+        return 200;
+    }
+
+    if (method == "POST" && IsSqlEndpoint(path))
+        return HandleQuery(config, body, GetParam(params, "format"),
+                           response);
+
+    response = ErrorBody("ResourceNotFoundException",
+                         "No handler found for " + method + " " + path, 404);
+    return 404;
+}
+
+int MockOpenSearchServer::HandleQuery(const mock_server_config& config,
+                                      const std::string& body,
+                                      const std::string& format,
+                                      std::string& response) {
+    std::string query, cursor;
+    size_t fetch_size = 0;
+    try {
+        rabbit::document doc;
+        doc.parse(body);
+        if (doc.has("query"))
+            query = doc["query"].as_string();
+        if (doc.has("cursor"))
+            cursor = doc["cursor"].as_string();
+        if (doc.has("fetch_size"))
+            fetch_size = std::stoul(doc["fetch_size"].str());
+    } catch (...) {
+        response = ErrorBody("IllegalArgumentException",
+                             "Failed to parse request body", 400);
+        return 400;
+    }
+
+    // The driver checks the plugin while connecting, that always succeeds
+    if (ToLower(query).compare(0, PLUGIN_CHECK_QUERY.size(),
+                               ToLower(PLUGIN_CHECK_QUERY))
+        == 0) {
+        std::scoped_lock lock(m_mutex);
+        m_metrics.query_requests++;
+        response = "{\"schema\":[{\"name\":\"TABLE_NAME\",\"type\":"
+                   "\"keyword\"}],\"datarows\":[],\"total\":0,\"size\":0,"
+                   "\"status\":200}";
+        return 200;
+    }
+
+    // Like the plugin, the flat formats are not paged
+    const bool flat = (format == "csv" || format == "raw");
+    if ((!format.empty() && format != "jdbc" && !flat)
+        || (flat && (fetch_size != 0 || !cursor.empty()))) {
+        response = ErrorBody("IllegalArgumentException",
+                             "response in " + format
+                                 + " format is not supported.",
+                             400);
+        return 400;
+    }
+
+    // A cursor holds the offset and size of the page it asks for
+    size_t offset = 0;
+    size_t page_rows = 0;
+    if (!cursor.empty()) {
+        std::istringstream ids(cursor.substr(
+            cursor.compare(0, CURSOR_PREFIX.size(), CURSOR_PREFIX) == 0
+                ? CURSOR_PREFIX.size()
+                : cursor.size()));
+        char separator = 0;
+        if (!(ids >> offset >> separator >> page_rows) || page_rows == 0) {
+            response = ErrorBody("IllegalArgumentException",
+                                 "Invalid cursor " + cursor, 400);
+            return 400;
+        }
+    } else {
+        page_rows = config.page_size != 0 ? config.page_size : fetch_size;
+    }
+
+    std::this_thread::sleep_for(config.latency);
+
+    const size_t page = (page_rows == 0) ? 1 : offset / page_rows + 1;
+    {
+        std::scoped_lock lock(m_mutex);
+        if (cursor.empty())
+            m_metrics.query_requests++;
+        else
+            m_metrics.cursor_requests++;
+        if (flat)
+            m_metrics.flat_requests++;
+        if (config.error_page == page)
+            m_metrics.errors++;
+    }
+    if (config.error_page == page) {
+        response = ErrorBody(config.error_type,
+                             "Error on page " + std::to_string(page),
+                             config.error_status);
+        return config.error_status;
+    }
+
+    response = flat ? GetFlatPage(config, format == "csv" ? ',' : '|')
+                    : GetPage(config, offset, page_rows, cursor.empty());
+    return 200;
+}
+
+std::string MockOpenSearchServer::GetPage(const mock_server_config& config,
+                                          size_t offset, size_t page_rows,
+                                          bool with_schema) {
+    // Without a fetch size the whole result comes in one capped response
+    const bool paginated = page_rows != 0;
+    const size_t end =
+        paginated ? std::min(config.total_rows, offset + page_rows)
+                  : std::min(config.total_rows, config.default_size);
+    offset = std::min(offset, end);
+
+    std::string page = "{";
+    if (with_schema) {
+        page += "\"schema\":[";
+        for (size_t col = 0; col < config.schema.size(); col++) {
+            page += (col == 0 ? "{\"name\":" : ",{\"name\":")
+                    + Quote(config.schema[col].first)
+                    + ",\"type\":" + Quote(config.schema[col].second) + "}";
+        }
+        page += "],";
+    }
+    page += "\"datarows\":[";
+    for (size_t row = offset; row < end; row++) {
+        page += (row == offset) ? "[" : ",[";
+        for (size_t col = 0; col < config.schema.size(); col++) {
+            if (col != 0)
+                page += ",";
+            page += GetValue(config, row, col);
+        }
+        page += "]";
+    }
+    page += "]";
+    if (with_schema) {
+        page += ",\"total\":" + std::to_string(config.total_rows)
+                + ",\"size\":" + std::to_string(end - offset)
+                + ",\"status\":200";
+    }
+    if (paginated && end < config.total_rows) {
+        page += ",\"cursor\":"
+                + Quote(CURSOR_PREFIX + std::to_string(end) + "_"
+                        + std::to_string(page_rows));
+    }
+    page += "}";
+
+    std::scoped_lock lock(m_mutex);
+    m_metrics.rows_sent += end - offset;
+    return page;
+}
+
+std::string MockOpenSearchServer::GetFlatPage(const mock_server_config& config,
+                                              char separator) {
+    const size_t end = std::min(config.total_rows, config.default_size);
+    std::string page;
+    for (size_t col = 0; col < config.schema.size(); col++) {
+        if (col != 0)
+            page += separator;
+        page += config.schema[col].first;
+    }
+    for (size_t row = 0; row < end; row++) {
+        page += "\n";
+        for (size_t col = 0; col < config.schema.size(); col++) {
+            if (col != 0)
+                page += separator;
+            page += FlatValue(GetValue(config, row, col), separator);
+        }
+    }
+
+    std::scoped_lock lock(m_mutex);
+    m_metrics.rows_sent += end;
+    return page;
+}
+
+std::string MockOpenSearchServer::GetValue(const mock_server_config& config,
+                                           size_t row, size_t col) {
+    if (config.null_interval != 0 && (row + 1) % config.null_interval == 0)
+        return "null";
+
+    const std::string& type = config.schema[col].second;
+    if (type == "integer" || type == "long" || type == "short"
+        || type == "byte")
+        return std::to_string(row * (col + 1));
+    if (type == "double" || type == "float" || type == "half_float"
+        || type == "scaled_float")
+        return std::to_string(row) + ".25";
+    if (type == "boolean")
+        return (row % 2 == 0) ? "true" : "false";
+    if (type == "date" || type == "timestamp")
+        return "\"2020-01-01 00:00:00\"";
+    return "\"value_" + std::to_string(row) + "_" + std::to_string(col)
+           + "\"";
+}
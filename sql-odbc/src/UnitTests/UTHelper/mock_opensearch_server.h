@@ -0,0 +1,111 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef MOCK_OPENSEARCH_SERVER
+#define MOCK_OPENSEARCH_SERVER
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// What the mock server returns for a query. Values are derived from the row
+// and column index, so every run sees the same result.
+typedef struct mock_server_config {
+    // Column names and OpenSearch type names
+    std::vector< std::pair< std::string, std::string > > schema = {
+        {"keyword_column", "keyword"},
+        {"integer_column", "integer"},
+        {"double_column", "double"},
+        {"boolean_column", "boolean"}};
+    size_t total_rows = 1000;
+    // Rows per page, 0 takes the fetch_size of the query. A query without a
+    // fetch_size gets up to default_size rows and no cursor.
+    size_t page_size = 0;
+    size_t default_size = 200;
+    // Every null_interval-th row has null values, 0 for none
+    size_t null_interval = 0;
+    // Delay before each page and server info response is sent
+    std::chrono::milliseconds latency = std::chrono::milliseconds(0);
+    // 1-based page that fails with error_status instead, 0 for none. The
+    // first page is the response to the query itself.
+    size_t error_page = 0;
+    int error_status = 500;
+    std::string error_type = "IllegalStateException";
+    std::string distribution = "opensearch";
+    std::string version = "1.1.0";
+} mock_server_config;
+
+// Requests served since the server started
+typedef struct mock_server_metrics {
+    size_t info_requests = 0;
+    size_t query_requests = 0;
+    // Queries answered in the csv or raw format
+    size_t flat_requests = 0;
+    size_t cursor_requests = 0;
+    size_t close_requests = 0;
+    size_t errors = 0;
+    size_t rows_sent = 0;
+    // Bodies as sent, after compression
+    size_t bytes_sent = 0;
+    // Responses gzipped for a client that accepts it
+    size_t compressed_responses = 0;
+    // Requests with an Authorization header, and the last such header
+    size_t authorized_requests = 0;
+    std::string last_authorization;
+} mock_server_metrics;
+
+// HTTP server on the loopback interface that answers like an OpenSearch
+// cluster with the SQL plugin: the root endpoint, SQL queries with cursor
+// pagination or in the csv and raw formats, and cursor close requests.
+// Responses are gzipped for clients that accept it. Each connection is served
+// by its own thread.
+class MockOpenSearchServer {
+   public:
+    MockOpenSearchServer();
+    explicit MockOpenSearchServer(const mock_server_config& config);
+    ~MockOpenSearchServer();
+
+    // Listens on an ephemeral port, returns false if it cannot
+    bool Start();
+    void Stop();
+    std::string GetHost() const;
+    std::string GetPort() const;
+    void SetConfig(const mock_server_config& config);
+    mock_server_metrics GetMetrics();
+
+   private:
+    void AcceptConnections();
+    void ServeConnection(std::intptr_t client);
+    int HandleRequest(const std::string& method, const std::string& path,
+                      const std::string& params, const std::string& body,
+                      std::string& response);
+    int HandleQuery(const mock_server_config& config, const std::string& body,
+                    const std::string& format, std::string& response);
+    bool IsSqlEndpoint(const std::string& path) const;
+    std::string GetPage(const mock_server_config& config, size_t offset,
+                        size_t page_rows, bool with_schema);
+    std::string GetFlatPage(const mock_server_config& config,
+                            char separator);
+    std::string GetValue(const mock_server_config& config, size_t row,
+                         size_t col);
+
+    mock_server_config m_config;
+    std::mutex m_mutex;
+    mock_server_metrics m_metrics;
+    std::atomic< bool > m_running;
+    std::intptr_t m_listen_socket;
+    unsigned short m_port;
+    std::thread m_accept_thread;
+    std::vector< std::thread > m_connection_threads;
+    std::vector< std::intptr_t > m_client_sockets;
+};
+
+#endif
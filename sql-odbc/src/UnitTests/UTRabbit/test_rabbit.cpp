@@ -167,6 +167,20 @@ TEST(ParseSchema, InvalidSchemaInvalidDoc) {
                  rabbit::parse_error);
 }
 
+TEST(ParseSchema, CompiledSchemaReused) {
+    rapidjson::Document schema_source;
+    schema_source.Parse(valid_json_schema.c_str());
+    ASSERT_FALSE(schema_source.HasParseError());
+    const rapidjson::SchemaDocument schema(schema_source);
+    for (int i = 0; i < 2; i++) {
+        rabbit::document valid_doc;
+        EXPECT_NO_THROW(valid_doc.parse(valid_json_for_schema, schema));
+        rabbit::document invalid_doc;
+        EXPECT_THROW(invalid_doc.parse(invalid_json_for_schema, schema),
+                     rabbit::parse_error);
+    }
+}
+
 TEST(ParseObj, ValidObj) {
     rabbit::document doc;
     EXPECT_NO_THROW(doc.parse(valid_json_obj));
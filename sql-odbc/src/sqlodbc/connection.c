@@ -155,6 +155,28 @@ RETCODE SQL_API OPENSEARCHAPI_BrowseConnect(HDBC hdbc, const SQLCHAR *szConnStrI
     return SQL_ERROR;
 }
 
+extern void *common_cs;
+
+/*
+ * Statements send their queries without holding the connection, it stays
+ * in use while one of them is executing or has an asynchronous call that
+ * was not collected yet.
+ */
+static BOOL CC_stmts_executing(ConnectionClass *self) {
+    int i;
+    BOOL executing = FALSE;
+
+    ENTER_COMMON_CS;
+    for (i = 0; i < self->num_stmts && !executing; i++) {
+        StatementClass *stmt = self->stmts[i];
+        if (NULL != stmt
+            && (STMT_EXECUTING == stmt->status || NULL != stmt->async_call))
+            executing = TRUE;
+    }
+    LEAVE_COMMON_CS;
+    return executing;
+}
+
 /* Drop any hstmts open on hdbc and disconnect from database */
 RETCODE SQL_API OPENSEARCHAPI_Disconnect(HDBC hdbc) {
     ConnectionClass *conn = (ConnectionClass *)hdbc;
@@ -168,9 +190,8 @@ RETCODE SQL_API OPENSEARCHAPI_Disconnect(HDBC hdbc) {
         return SQL_INVALID_HANDLE;
     }
 
-    if (conn->status == CONN_EXECUTING) {
-        // This should only be possible if transactions are supported, but they
-        // are not. Return an error regardless
+    if (conn->status == CONN_EXECUTING || CC_stmts_executing(conn)) {
+        // A statement still runs its query over the connection
         CC_set_error(conn, CONN_IN_USE, "Connection is currently in use!",
                      func);
         return SQL_ERROR;
@@ -407,6 +428,11 @@ CC_cleanup(ConnectionClass *self, BOOL keepCommunication) {
     /* We are always in the middle of a transaction, */
     /* even if we are in auto commit. */
     if (self->opensearchconn) {
+        /* The statements may still be retrieving pages over it */
+        for (i = 0; i < self->num_stmts; i++) {
+            if (self->stmts[i])
+                OpenSearchStopStream(self->stmts[i]->result_stream);
+        }
         QLOG(0, "LIBOPENSEARCH_disconnect: %p\n", self->opensearchconn);
         LIBOPENSEARCH_disconnect(self->opensearchconn);
         self->opensearchconn = NULL;
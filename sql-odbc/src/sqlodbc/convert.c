@@ -568,7 +568,8 @@ static void set_client_decimal_point(char *num) {
 
 /*	This is called by SQLFetch() */
 int copy_and_convert_field_bindinfo(StatementClass *stmt, OID field_type,
-                                    int atttypmod, void *value, int col) {
+                                    int atttypmod, TupleField *tuple_field,
+                                    int col) {
     ARDFields *opts = SC_get_ARDF(stmt);
     BindInfoClass *bic;
     SQLULEN offset = opts->row_offset_ptr ? *opts->row_offset_ptr : 0;
@@ -577,7 +578,7 @@ int copy_and_convert_field_bindinfo(StatementClass *stmt, OID field_type,
         extend_column_bindings(opts, (SQLSMALLINT)(col + 1));
     bic = &(opts->bindings[col]);
     SC_set_current_col(stmt, -1);
-    return copy_and_convert_field(stmt, field_type, atttypmod, value,
+    return copy_and_convert_field(stmt, field_type, atttypmod, tuple_field,
                                   bic->returntype, bic->precision,
                                   (PTR)(bic->buffer + offset), bic->buflen,
                                   LENADDR_SHIFT(bic->used, offset),
@@ -975,12 +976,74 @@ cleanup:
     return result;
 }
 
+/*
+ *	Stores the native copy of a backend value into a fixed size C buffer.
+ *	Returns the length written, or 0 if the value has no native copy or
+ *	fCType needs the text conversion.
+ */
+SQLLEN copy_native_field(const TupleField *tuple_field, SQLSMALLINT fCType,
+                         PTR rgbValue, SQLLEN bind_row, int bind_size) {
+    char *rgbValueBindRow = (char *)rgbValue + bind_size * bind_row;
+    BOOL is_float8;
+    Int8 int8;
+
+    if (TUPLE_NATIVE_NONE == tuple_field->native)
+        return 0;
+    is_float8 = (TUPLE_NATIVE_FLOAT8 == tuple_field->native);
+    int8 = tuple_field->native_value.int8;
+    switch (fCType) {
+        case SQL_C_SLONG:
+        case SQL_C_LONG:
+            if (is_float8)
+                return 0;
+            if (bind_size > 0)
+                *((SQLINTEGER *)rgbValueBindRow) = (SQLINTEGER)int8;
+            else
+                *((SQLINTEGER *)rgbValue + bind_row) = (SQLINTEGER)int8;
+            return 4;
+
+#ifdef ODBCINT64
+        case SQL_C_SBIGINT:
+            if (is_float8)
+                return 0;
+            if (bind_size > 0)
+                *((SQLBIGINT *)rgbValueBindRow) = (SQLBIGINT)int8;
+            else
+                *((SQLBIGINT *)rgbValue + bind_row) = (SQLBIGINT)int8;
+            return 8;
+#endif /* ODBCINT64 */
+
+        case SQL_C_DOUBLE: {
+            SDOUBLE dval = is_float8 ? (SDOUBLE)tuple_field->native_value.float8
+                                     : (SDOUBLE)int8;
+            if (bind_size > 0)
+                *((SDOUBLE *)rgbValueBindRow) = dval;
+            else
+                *((SDOUBLE *)rgbValue + bind_row) = dval;
+            return 8;
+        }
+
+        case SQL_C_BIT:
+            if (is_float8)
+                return 0;
+            if (bind_size > 0)
+                *((UCHAR *)rgbValueBindRow) = (UCHAR)int8;
+            else
+                *((UCHAR *)rgbValue + bind_row) = (UCHAR)int8;
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
 /*	This is called by SQLGetData() */
 int copy_and_convert_field(StatementClass *stmt, OID field_type, int atttypmod,
-                           void *valuei, SQLSMALLINT fCType, int precision,
-                           PTR rgbValue, SQLLEN cbValueMax, SQLLEN *pcbValue,
-                           SQLLEN *pIndicator) {
+                           TupleField *tuple_field, SQLSMALLINT fCType,
+                           int precision, PTR rgbValue, SQLLEN cbValueMax,
+                           SQLLEN *pcbValue, SQLLEN *pIndicator) {
     CSTR func = "copy_and_convert_field";
+    void *valuei = tuple_field ? tuple_field->value : NULL;
     const char *value = valuei;
     ARDFields *opts = SC_get_ARDF(stmt);
     GetDataInfo *gdata = SC_get_GDTI(stmt);
@@ -1071,6 +1134,23 @@ int copy_and_convert_field(StatementClass *stmt, OID field_type, int atttypmod,
         }
     }
 
+    /*
+     * Numbers and booleans decoded while reading the response go straight
+     * into numeric buffers, the text is only parsed for other targets.
+     */
+    if (NULL != rgbValue) {
+        len = copy_native_field(tuple_field, fCType, rgbValue, bind_row,
+                                bind_size);
+        if (len > 0) {
+            if (pcbValue)
+                *pcbValueBindRow = len;
+            if (stmt->current_col >= 0)
+                gdata->gdata[stmt->current_col].data_left = 0;
+            return COPY_OK;
+        }
+        len = 0;
+    }
+
     if (stmt->hdbc->DataSourceToDriver != NULL) {
         size_t length = strlen(value);
 
@@ -22,12 +22,17 @@ extern "C" {
 #define COPY_INVALID_STRING_CONVERSION 6
 
 int copy_and_convert_field_bindinfo(StatementClass *stmt, OID field_type,
-                                    int atttypmod, void *value, int col);
+                                    int atttypmod, TupleField *tuple_field,
+                                    int col);
 int copy_and_convert_field(StatementClass *stmt, OID field_type, int atttypmod,
-                           void *value, SQLSMALLINT fCType, int precision,
+                           TupleField *tuple_field, SQLSMALLINT fCType,
+                           int precision,
                            PTR rgbValue, SQLLEN cbValueMax, SQLLEN *pcbValue,
                            SQLLEN *pIndicator);
 
+SQLLEN copy_native_field(const TupleField *tuple_field, SQLSMALLINT fCType,
+                         PTR rgbValue, SQLLEN bind_row, int bind_size);
+
 SQLLEN opensearch_hex2bin(const char *in, char *out, SQLLEN len);
 
 #ifdef __cplusplus
@@ -50,12 +50,21 @@ void makeConnectString(char *connect_string, const ConnInfo *ci, UWORD len) {
         "database=OpenSearch;" INI_PORT "=%s;" INI_USERNAME_ABBR
         "=%s;" INI_PASSWORD_ABBR "=%s;" INI_AUTH_MODE "=%s;" INI_REGION
         "=%s;" INI_SSL_USE "=%d;" INI_SSL_HOST_VERIFY "=%d;" INI_LOG_LEVEL
-        "=%d;" INI_LOG_OUTPUT "=%s;" INI_TIMEOUT "=%s;" INI_FETCH_SIZE "=%s;",
+        "=%d;" INI_LOG_OUTPUT "=%s;" INI_TIMEOUT "=%s;" INI_FETCH_SIZE
+        "=%s;" INI_DOM_PARSER "=%d;" INI_PREFETCH_DEPTH "=%s;"
+        INI_SKIP_CURSOR_VALIDATION "=%d;" INI_STREAMING_CURSOR "=%d;"
+        INI_QUERY_CACHE_TTL "=%s;" INI_QUERY_CACHE_SIZE "=%s;"
+        INI_METADATA_CACHE_TTL "=%s;" INI_SHARED_METADATA_CACHE "=%d;"
+        INI_IO_THREADS "=%s;" INI_RESPONSE_FORMAT "=%s;" INI_COMPRESSION "=%d;",
         got_dsn ? "DSN" : "DRIVER", got_dsn ? ci->dsn : ci->drivername,
         ci->server, ci->port, ci->username, encoded_item, ci->authtype,
         ci->region, (int)ci->use_ssl, (int)ci->verify_server,
         (int)ci->drivers.loglevel, ci->drivers.output_dir,
-        ci->response_timeout, ci->fetch_size);
+        ci->response_timeout, ci->fetch_size, (int)ci->use_dom_parser,
+        ci->prefetch_depth, (int)ci->skip_cursor_validation,
+        (int)ci->streaming_cursor, ci->query_cache_ttl, ci->query_cache_size,
+        ci->metadata_cache_ttl, (int)ci->shared_metadata_cache, ci->io_threads,
+        ci->response_format, (int)ci->compression);
     if (olen < 0 || olen >= nlen) {
         connect_string[0] = '\0';
         return;
@@ -127,6 +136,28 @@ BOOL copyConnAttributes(ConnInfo *ci, const char *attribute,
         STRCPY_FIXED(ci->response_timeout, value);
     else if (stricmp(attribute, INI_FETCH_SIZE) == 0)
         STRCPY_FIXED(ci->fetch_size, value);
+    else if (stricmp(attribute, INI_DOM_PARSER) == 0)
+        ci->use_dom_parser = (char)atoi(value);
+    else if (stricmp(attribute, INI_PREFETCH_DEPTH) == 0)
+        STRCPY_FIXED(ci->prefetch_depth, value);
+    else if (stricmp(attribute, INI_SKIP_CURSOR_VALIDATION) == 0)
+        ci->skip_cursor_validation = (char)atoi(value);
+    else if (stricmp(attribute, INI_STREAMING_CURSOR) == 0)
+        ci->streaming_cursor = (char)atoi(value);
+    else if (stricmp(attribute, INI_QUERY_CACHE_TTL) == 0)
+        STRCPY_FIXED(ci->query_cache_ttl, value);
+    else if (stricmp(attribute, INI_QUERY_CACHE_SIZE) == 0)
+        STRCPY_FIXED(ci->query_cache_size, value);
+    else if (stricmp(attribute, INI_METADATA_CACHE_TTL) == 0)
+        STRCPY_FIXED(ci->metadata_cache_ttl, value);
+    else if (stricmp(attribute, INI_SHARED_METADATA_CACHE) == 0)
+        ci->shared_metadata_cache = (char)atoi(value);
+    else if (stricmp(attribute, INI_IO_THREADS) == 0)
+        STRCPY_FIXED(ci->io_threads, value);
+    else if (stricmp(attribute, INI_RESPONSE_FORMAT) == 0)
+        STRCPY_FIXED(ci->response_format, value);
+    else if (stricmp(attribute, INI_COMPRESSION) == 0)
+        ci->compression = (char)atoi(value);
     else
         found = FALSE;
 
@@ -154,6 +185,20 @@ static void getCiDefaults(ConnInfo *ci) {
     strncpy(ci->region, DEFAULT_REGION, MEDIUM_REGISTRY_LEN);
     ci->use_ssl = DEFAULT_USE_SSL;
     ci->verify_server = DEFAULT_VERIFY_SERVER;
+    ci->use_dom_parser = DEFAULT_DOM_PARSER;
+    strncpy(ci->prefetch_depth, DEFAULT_PREFETCH_DEPTH_STR, SMALL_REGISTRY_LEN);
+    ci->skip_cursor_validation = DEFAULT_SKIP_CURSOR_VALIDATION;
+    ci->streaming_cursor = DEFAULT_STREAMING_CURSOR;
+    strncpy(ci->query_cache_ttl, DEFAULT_QUERY_CACHE_TTL_STR,
+            SMALL_REGISTRY_LEN);
+    strncpy(ci->query_cache_size, DEFAULT_QUERY_CACHE_SIZE_STR,
+            SMALL_REGISTRY_LEN);
+    strncpy(ci->metadata_cache_ttl, DEFAULT_METADATA_CACHE_TTL_STR,
+            SMALL_REGISTRY_LEN);
+    ci->shared_metadata_cache = DEFAULT_SHARED_METADATA_CACHE;
+    strncpy(ci->io_threads, DEFAULT_IO_THREADS_STR, SMALL_REGISTRY_LEN);
+    strncpy(ci->response_format, DEFAULT_RESPONSE_FORMAT, SMALL_REGISTRY_LEN);
+    ci->compression = DEFAULT_COMPRESSION;
     strcpy(ci->drivers.output_dir, "C:\\");
 }
 
@@ -280,6 +325,50 @@ void getDSNinfo(ConnInfo *ci, const char *configDrvrname) {
                                    sizeof(temp), ODBC_INI)
         > 0)
         STRCPY_FIXED(ci->fetch_size, temp);
+    if (SQLGetPrivateProfileString(DSN, INI_DOM_PARSER, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        ci->use_dom_parser = (char)atoi(temp);
+    if (SQLGetPrivateProfileString(DSN, INI_PREFETCH_DEPTH, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        STRCPY_FIXED(ci->prefetch_depth, temp);
+    if (SQLGetPrivateProfileString(DSN, INI_SKIP_CURSOR_VALIDATION, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        ci->skip_cursor_validation = (char)atoi(temp);
+    if (SQLGetPrivateProfileString(DSN, INI_STREAMING_CURSOR, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        ci->streaming_cursor = (char)atoi(temp);
+    if (SQLGetPrivateProfileString(DSN, INI_QUERY_CACHE_TTL, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        STRCPY_FIXED(ci->query_cache_ttl, temp);
+    if (SQLGetPrivateProfileString(DSN, INI_QUERY_CACHE_SIZE, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        STRCPY_FIXED(ci->query_cache_size, temp);
+    if (SQLGetPrivateProfileString(DSN, INI_METADATA_CACHE_TTL, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        STRCPY_FIXED(ci->metadata_cache_ttl, temp);
+    if (SQLGetPrivateProfileString(DSN, INI_SHARED_METADATA_CACHE, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        ci->shared_metadata_cache = (char)atoi(temp);
+    if (SQLGetPrivateProfileString(DSN, INI_IO_THREADS, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        STRCPY_FIXED(ci->io_threads, temp);
+    if (SQLGetPrivateProfileString(DSN, INI_RESPONSE_FORMAT, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        STRCPY_FIXED(ci->response_format, temp);
+    if (SQLGetPrivateProfileString(DSN, INI_COMPRESSION, NULL_STRING, temp,
+                                   sizeof(temp), ODBC_INI)
+        > 0)
+        ci->compression = (char)atoi(temp);
     STR_TO_NAME(ci->drivers.drivername, drivername);
 }
 /*
@@ -322,6 +411,27 @@ void writeDSNinfo(const ConnInfo *ci) {
                                  ODBC_INI);
     SQLWritePrivateProfileString(DSN, INI_FETCH_SIZE, ci->fetch_size,
                                  ODBC_INI);
+    ITOA_FIXED(temp, ci->use_dom_parser);
+    SQLWritePrivateProfileString(DSN, INI_DOM_PARSER, temp, ODBC_INI);
+    SQLWritePrivateProfileString(DSN, INI_PREFETCH_DEPTH, ci->prefetch_depth,
+                                 ODBC_INI);
+    ITOA_FIXED(temp, ci->skip_cursor_validation);
+    SQLWritePrivateProfileString(DSN, INI_SKIP_CURSOR_VALIDATION, temp, ODBC_INI);
+    ITOA_FIXED(temp, ci->streaming_cursor);
+    SQLWritePrivateProfileString(DSN, INI_STREAMING_CURSOR, temp, ODBC_INI);
+    SQLWritePrivateProfileString(DSN, INI_QUERY_CACHE_TTL, ci->query_cache_ttl,
+                                 ODBC_INI);
+    SQLWritePrivateProfileString(DSN, INI_QUERY_CACHE_SIZE,
+                                 ci->query_cache_size, ODBC_INI);
+    SQLWritePrivateProfileString(DSN, INI_METADATA_CACHE_TTL,
+                                 ci->metadata_cache_ttl, ODBC_INI);
+    ITOA_FIXED(temp, ci->shared_metadata_cache);
+    SQLWritePrivateProfileString(DSN, INI_SHARED_METADATA_CACHE, temp, ODBC_INI);
+    SQLWritePrivateProfileString(DSN, INI_IO_THREADS, ci->io_threads, ODBC_INI);
+    SQLWritePrivateProfileString(DSN, INI_RESPONSE_FORMAT, ci->response_format,
+                                 ODBC_INI);
+    ITOA_FIXED(temp, ci->compression);
+    SQLWritePrivateProfileString(DSN, INI_COMPRESSION, temp, ODBC_INI);
 
 }
 
@@ -462,6 +572,22 @@ void CC_conninfo_init(ConnInfo *conninfo, UInt4 option) {
     strncpy(conninfo->region, DEFAULT_REGION, MEDIUM_REGISTRY_LEN);
     conninfo->use_ssl = DEFAULT_USE_SSL;
     conninfo->verify_server = DEFAULT_VERIFY_SERVER;
+    conninfo->use_dom_parser = DEFAULT_DOM_PARSER;
+    strncpy(conninfo->prefetch_depth, DEFAULT_PREFETCH_DEPTH_STR,
+            SMALL_REGISTRY_LEN);
+    conninfo->skip_cursor_validation = DEFAULT_SKIP_CURSOR_VALIDATION;
+    conninfo->streaming_cursor = DEFAULT_STREAMING_CURSOR;
+    strncpy(conninfo->query_cache_ttl, DEFAULT_QUERY_CACHE_TTL_STR,
+            SMALL_REGISTRY_LEN);
+    strncpy(conninfo->query_cache_size, DEFAULT_QUERY_CACHE_SIZE_STR,
+            SMALL_REGISTRY_LEN);
+    strncpy(conninfo->metadata_cache_ttl, DEFAULT_METADATA_CACHE_TTL_STR,
+            SMALL_REGISTRY_LEN);
+    conninfo->shared_metadata_cache = DEFAULT_SHARED_METADATA_CACHE;
+    strncpy(conninfo->io_threads, DEFAULT_IO_THREADS_STR, SMALL_REGISTRY_LEN);
+    strncpy(conninfo->response_format, DEFAULT_RESPONSE_FORMAT,
+            SMALL_REGISTRY_LEN);
+    conninfo->compression = DEFAULT_COMPRESSION;
 
     if (0 != (INIT_GLOBALS & option))
         init_globals(&(conninfo->drivers));
@@ -506,6 +632,17 @@ void CC_copy_conninfo(ConnInfo *ci, const ConnInfo *sci) {
     CORR_STRCPY(port);
     CORR_STRCPY(response_timeout);
     CORR_STRCPY(fetch_size);
+    CORR_VALCPY(use_dom_parser);
+    CORR_STRCPY(prefetch_depth);
+    CORR_VALCPY(skip_cursor_validation);
+    CORR_VALCPY(streaming_cursor);
+    CORR_STRCPY(query_cache_ttl);
+    CORR_STRCPY(query_cache_size);
+    CORR_STRCPY(metadata_cache_ttl);
+    CORR_VALCPY(shared_metadata_cache);
+    CORR_STRCPY(io_threads);
+    CORR_STRCPY(response_format);
+    CORR_VALCPY(compression);
     copy_globals(&(ci->drivers), &(sci->drivers));
 }
 #undef CORR_STRCPY
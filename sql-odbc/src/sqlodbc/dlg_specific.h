@@ -56,6 +56,17 @@ extern "C" {
 #define INI_LOG_OUTPUT "logOutput"
 #define INI_TIMEOUT "responseTimeout"
 #define INI_FETCH_SIZE "fetchSize"
+#define INI_DOM_PARSER "useDomParser"
+#define INI_PREFETCH_DEPTH "prefetchDepth"
+#define INI_SKIP_CURSOR_VALIDATION "skipCursorValidation"
+#define INI_STREAMING_CURSOR "streamingCursor"
+#define INI_QUERY_CACHE_TTL "queryCacheTTL"
+#define INI_QUERY_CACHE_SIZE "queryCacheSize"
+#define INI_METADATA_CACHE_TTL "metadataCacheTTL"
+#define INI_SHARED_METADATA_CACHE "sharedMetadataCache"
+#define INI_IO_THREADS "ioThreads"
+#define INI_RESPONSE_FORMAT "responseFormat"
+#define INI_COMPRESSION "compression"
 
 #define DEFAULT_FETCH_SIZE -1
 #define DEFAULT_FETCH_SIZE_STR "-1"
@@ -71,6 +82,22 @@ extern "C" {
 #define DEFAULT_DSN ""
 #define DEFAULT_REGION ""
 #define DEFAULT_VERIFY_SERVER 1
+#define DEFAULT_DOM_PARSER 0
+#define DEFAULT_PREFETCH_DEPTH 2
+#define DEFAULT_PREFETCH_DEPTH_STR "2"
+#define DEFAULT_SKIP_CURSOR_VALIDATION 0
+#define DEFAULT_STREAMING_CURSOR 1
+#define DEFAULT_QUERY_CACHE_TTL 0
+#define DEFAULT_QUERY_CACHE_TTL_STR "0"
+#define DEFAULT_QUERY_CACHE_SIZE 64
+#define DEFAULT_QUERY_CACHE_SIZE_STR "64"
+#define DEFAULT_METADATA_CACHE_TTL 0
+#define DEFAULT_METADATA_CACHE_TTL_STR "0"
+#define DEFAULT_SHARED_METADATA_CACHE 0
+#define DEFAULT_IO_THREADS 0
+#define DEFAULT_IO_THREADS_STR "0"
+#define DEFAULT_RESPONSE_FORMAT "jdbc"
+#define DEFAULT_COMPRESSION 0
 
 #define AUTHTYPE_NONE "NONE"
 #define AUTHTYPE_BASIC "BASIC"
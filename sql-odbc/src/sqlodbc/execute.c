@@ -37,7 +37,7 @@ RETCODE SQL_API OPENSEARCHAPI_Prepare(HSTMT hstmt, const SQLCHAR *stmt_str,
     if (ret != SQL_SUCCESS)
         return ret;
 
-    // Execute the statement
+    // Describe the result columns, the query itself runs in SQLExecute
     ret = ExecuteStatement(stmt, FALSE);
     if (ret == SQL_SUCCESS)
         stmt->prepared = PREPARED;
@@ -54,9 +54,6 @@ RETCODE SQL_API OPENSEARCHAPI_Execute(HSTMT hstmt) {
     RETCODE ret = SQL_ERROR;
     switch (stmt->prepared) {
         case PREPARED:
-            ret = AssignResult(stmt);
-            stmt->prepared = EXECUTED;
-            break;
         case EXECUTED:
             ret = RePrepareStatement(stmt);
             if (ret != SQL_SUCCESS)
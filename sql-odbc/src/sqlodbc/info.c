@@ -640,7 +640,7 @@ RETCODE SQL_API OPENSEARCHAPI_GetInfo(HDBC hdbc, SQLUSMALLINT fInfoType,
             break;
         case SQL_ASYNC_MODE:
             len = 4;
-            value = SQL_AM_NONE;
+            value = SQL_AM_STATEMENT;
             break;
         case SQL_BATCH_ROW_COUNT:
             len = 4;
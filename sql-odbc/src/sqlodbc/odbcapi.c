@@ -38,6 +38,8 @@ RETCODE SQL_API SQLBindCol(HSTMT StatementHandle, SQLUSMALLINT ColumnNumber,
     StatementClass *stmt = (StatementClass *)StatementHandle;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_BindCol(StatementHandle, ColumnNumber, TargetType, TargetValue,
@@ -80,6 +82,8 @@ RETCODE SQL_API SQLColumns(HSTMT StatementHandle, SQLCHAR *CatalogName,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (stmt->options.metadata_id)
@@ -209,6 +213,8 @@ RETCODE SQL_API SQLDescribeCol(HSTMT StatementHandle, SQLUSMALLINT ColumnNumber,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_DescribeCol(StatementHandle, ColumnNumber, ColumnName,
@@ -235,6 +241,32 @@ RETCODE SQL_API SQLDisconnect(HDBC ConnectionHandle) {
     return ret;
 }
 
+/* args is the statement text as a null terminated string */
+RETCODE AsyncExecDirect(StatementClass *stmt, void *args) {
+    RETCODE ret = SQL_ERROR;
+    if (!SC_opencheck(stmt, "SQLExecDirect"))
+        ret = OPENSEARCHAPI_ExecDirect(stmt, (const SQLCHAR *)args, SQL_NTS, 1);
+    return ret;
+}
+
+static RETCODE AsyncExecute(StatementClass *stmt, void *args) {
+    UNUSED(args);
+    RETCODE ret = SQL_ERROR;
+    if (!SC_opencheck(stmt, "SQLExecute"))
+        ret = OPENSEARCHAPI_Execute(stmt);
+    return ret;
+}
+
+static RETCODE AsyncFetch(StatementClass *stmt, void *args) {
+    UNUSED(args);
+    IRDFields *irdopts = SC_get_IRDF(stmt);
+    RETCODE ret = OPENSEARCHAPI_ExtendedFetch(
+        stmt, SQL_FETCH_NEXT, 0, irdopts->rowsFetched,
+        irdopts->rowStatusArray, 0, SC_get_ARDF(stmt)->size_of_rowset);
+    stmt->transition_status = STMT_TRANSITION_FETCH_SCROLL;
+    return ret;
+}
+
 #ifndef UNICODE_SUPPORTXX
 RETCODE SQL_API SQLExecDirect(HSTMT StatementHandle, SQLCHAR *StatementText,
                               SQLINTEGER TextLength) {
@@ -245,6 +277,14 @@ RETCODE SQL_API SQLExecDirect(HSTMT StatementHandle, SQLCHAR *StatementText,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    // Execute on the driver executor, or report on the running call
+    RETCODE ret = SQL_ERROR;
+    if (PollAsyncCall(stmt, SQL_API_SQLEXECDIRECT, &ret))
+        return ret;
+    if (SC_is_async(stmt))
+        return StartAsyncCall(stmt, SQL_API_SQLEXECDIRECT, AsyncExecDirect,
+                              make_string(StatementText, TextLength, NULL, 0));
+
     // Enter critical
     ENTER_STMT_CS(stmt);
 
@@ -252,7 +292,6 @@ RETCODE SQL_API SQLExecDirect(HSTMT StatementHandle, SQLCHAR *StatementText,
     SC_clear_error(stmt);
 
     // Execute statement if statement is ready
-    RETCODE ret = SQL_ERROR;
     if (!SC_opencheck(stmt, "SQLExecDirect"))
         ret = OPENSEARCHAPI_ExecDirect(StatementHandle, StatementText, TextLength, 1);
 
@@ -272,12 +311,17 @@ RETCODE SQL_API SQLExecute(HSTMT StatementHandle) {
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    RETCODE ret = SQL_ERROR;
+    if (PollAsyncCall(stmt, SQL_API_SQLEXECUTE, &ret))
+        return ret;
+    if (SC_is_async(stmt))
+        return StartAsyncCall(stmt, SQL_API_SQLEXECUTE, AsyncExecute, NULL);
+
     // Enter critical
     ENTER_STMT_CS(stmt);
 
     // Clear error and rollback
     SC_clear_error(stmt);
-    RETCODE ret = SQL_ERROR;
     if (!SC_opencheck(stmt, "SQLExecute"))
         ret = OPENSEARCHAPI_Execute(StatementHandle);
 
@@ -298,6 +342,12 @@ RETCODE SQL_API SQLFetch(HSTMT StatementHandle) {
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    // Only a fetch waiting for the next result page runs asynchronously
+    if (PollAsyncCall(stmt, SQL_API_SQLFETCH, &ret))
+        return ret;
+    if (SC_is_async(stmt) && FetchNeedsNextPage(stmt))
+        return StartAsyncCall(stmt, SQL_API_SQLFETCH, AsyncFetch, NULL);
+
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_ExtendedFetch(StatementHandle, SQL_FETCH_NEXT, 0, pcRow,
@@ -316,6 +366,8 @@ RETCODE SQL_API SQLFreeStmt(HSTMT StatementHandle, SQLUSMALLINT Option) {
     MYLOG(OPENSEARCH_TRACE, "entering\n");
 
     if (stmt) {
+        if (AsyncCallPending(stmt))
+            return SQL_ERROR;
         if (Option == SQL_DROP) {
             conn = stmt->hdbc;
             if (conn)
@@ -345,6 +397,8 @@ RETCODE SQL_API SQLGetCursorName(HSTMT StatementHandle, SQLCHAR *CursorName,
     StatementClass *stmt = (StatementClass *)StatementHandle;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_GetCursorName(StatementHandle, CursorName, BufferLength,
@@ -364,6 +418,8 @@ RETCODE SQL_API SQLGetData(HSTMT StatementHandle, SQLUSMALLINT ColumnNumber,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_GetData(StatementHandle, ColumnNumber, TargetType, TargetValue,
@@ -417,6 +473,8 @@ RETCODE SQL_API SQLGetTypeInfo(HSTMT StatementHandle, SQLSMALLINT DataType) {
                                  __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (SC_opencheck(stmt, func))
@@ -437,6 +495,8 @@ RETCODE SQL_API SQLNumResultCols(HSTMT StatementHandle,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_NumResultCols(StatementHandle, ColumnCount);
@@ -449,6 +509,8 @@ RETCODE SQL_API SQLParamData(HSTMT StatementHandle, PTR *Value) {
     StatementClass *stmt = (StatementClass *)StatementHandle;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "OpenSearch does not support parameters.", "SQLParamData");
@@ -469,6 +531,8 @@ RETCODE SQL_API SQLPrepare(HSTMT StatementHandle, SQLCHAR *StatementText,
         return SQL_ERROR;
 
     // Enter critical
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
 
     // Clear error and rollback
@@ -491,6 +555,8 @@ RETCODE SQL_API SQLPutData(HSTMT StatementHandle, PTR Data,
     StatementClass *stmt = (StatementClass *)StatementHandle;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "OpenSearch does not support parameters.", "SQLPutData");
@@ -505,6 +571,8 @@ RETCODE SQL_API SQLRowCount(HSTMT StatementHandle, SQLLEN *RowCount) {
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_RowCount(StatementHandle, RowCount);
@@ -519,6 +587,8 @@ RETCODE SQL_API SQLSetCursorName(HSTMT StatementHandle, SQLCHAR *CursorName,
     StatementClass *stmt = (StatementClass *)StatementHandle;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_SetCursorName(StatementHandle, CursorName, NameLength);
@@ -536,6 +606,8 @@ RETCODE SQL_API SQLSetParam(HSTMT StatementHandle, SQLUSMALLINT ParameterNumber,
     StatementClass *stmt = (StatementClass *)StatementHandle;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "OpenSearch does not support parameters.", "SQLSetParam");
@@ -558,6 +630,8 @@ RETCODE SQL_API SQLSpecialColumns(HSTMT StatementHandle,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (SC_opencheck(stmt, func))
@@ -619,6 +693,8 @@ RETCODE SQL_API SQLStatistics(HSTMT StatementHandle, SQLCHAR *CatalogName,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (SC_opencheck(stmt, func))
@@ -681,6 +757,8 @@ RETCODE SQL_API SQLTables(HSTMT StatementHandle, SQLCHAR *CatalogName,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (stmt->options.metadata_id)
@@ -745,6 +823,8 @@ RETCODE SQL_API SQLColumnPrivileges(
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (stmt->options.metadata_id)
@@ -809,6 +889,8 @@ RETCODE SQL_API SQLDescribeParam(HSTMT hstmt, SQLUSMALLINT ipar,
                                  SQLSMALLINT *pfNullable) {
     UNUSED(ipar, pfSqlType, pcbParamDef, pibScale, pfNullable);
     StatementClass *stmt = (StatementClass *)hstmt;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
 
     // COLNUM_ERROR translates to 'invalid descriptor index'
@@ -832,6 +914,8 @@ RETCODE SQL_API SQLExtendedFetch(HSTMT hstmt, SQLUSMALLINT fFetchType,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
 #ifdef WITH_UNIXODBC
@@ -872,6 +956,8 @@ RETCODE SQL_API SQLForeignKeys(
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (SC_opencheck(stmt, func))
@@ -955,6 +1041,8 @@ RETCODE SQL_API SQLMoreResults(HSTMT hstmt) {
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_MoreResults(hstmt);
@@ -986,6 +1074,8 @@ RETCODE SQL_API SQLNumParams(HSTMT hstmt, SQLSMALLINT *pcpar) {
     StatementClass *stmt = (StatementClass *)hstmt;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "OpenSearch does not support parameters.", "SQLNumParams");
@@ -1007,6 +1097,8 @@ RETCODE SQL_API SQLPrimaryKeys(HSTMT hstmt, SQLCHAR *szCatalogName,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (SC_opencheck(stmt, func))
@@ -1067,6 +1159,8 @@ RETCODE SQL_API SQLProcedureColumns(
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (stmt->options.metadata_id)
@@ -1139,6 +1233,8 @@ RETCODE SQL_API SQLProcedures(HSTMT hstmt, SQLCHAR *szCatalogName,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (stmt->options.metadata_id)
@@ -1193,6 +1289,8 @@ RETCODE SQL_API SQLSetPos(HSTMT hstmt, SQLSETPOSIROW irow, SQLUSMALLINT fOption,
     StatementClass *stmt = (StatementClass *)hstmt;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "SQLSetPos is not supported.", "SQLSetPos");
@@ -1217,6 +1315,8 @@ RETCODE SQL_API SQLTablePrivileges(HSTMT hstmt, SQLCHAR *szCatalogName,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (stmt->options.metadata_id)
@@ -1275,6 +1375,8 @@ RETCODE SQL_API SQLBindParameter(HSTMT hstmt, SQLUSMALLINT ipar,
     StatementClass *stmt = (StatementClass *)hstmt;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "OpenSearch does not support parameters.",
@@ -1349,6 +1451,8 @@ SQLRETURN SQL_API SQLColAttributes(SQLHSTMT StatementHandle,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_ColAttributes(StatementHandle, ColumnNumber, FieldIdentifier,
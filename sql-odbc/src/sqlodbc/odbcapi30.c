@@ -12,6 +12,7 @@
 #include "misc.h"
 #include "opensearch_apifunc.h"
 #include "opensearch_connection.h"
+#include "opensearch_statement.h"
 #include "statement.h"
 
 /*	SQLAllocConnect/SQLAllocEnv/SQLAllocStmt -> SQLAllocHandle */
@@ -66,6 +67,8 @@ RETCODE SQL_API SQLBindParam(HSTMT StatementHandle,
     StatementClass *stmt = (StatementClass *)StatementHandle;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "OpenSearch does not support parameters.", "SQLBindParam");
@@ -84,6 +87,8 @@ RETCODE SQL_API SQLCloseCursor(HSTMT StatementHandle) {
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_FreeStmt(StatementHandle, SQL_CLOSE);
@@ -112,6 +117,8 @@ SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_ColAttributes(StatementHandle, ColumnNumber, FieldIdentifier,
@@ -171,6 +178,8 @@ RETCODE SQL_API SQLFetchScroll(HSTMT StatementHandle,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (FetchOrientation == SQL_FETCH_BOOKMARK) {
@@ -219,6 +228,8 @@ RETCODE SQL_API SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) {
             stmt = (StatementClass *)Handle;
 
             if (stmt) {
+                if (AsyncCallPending(stmt))
+                    return SQL_ERROR;
                 conn = stmt->hdbc;
                 if (conn)
                     ENTER_CONN_CS(conn);
@@ -359,6 +370,8 @@ RETCODE SQL_API SQLGetStmtAttr(HSTMT StatementHandle, SQLINTEGER Attribute,
 
     MYLOG(OPENSEARCH_TRACE, "entering Handle=%p " FORMAT_INTEGER "\n", StatementHandle,
           Attribute);
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_GetStmtAttr(StatementHandle, Attribute, Value, BufferLength,
@@ -473,6 +486,8 @@ RETCODE SQL_API SQLSetStmtAttr(HSTMT StatementHandle, SQLINTEGER Attribute,
 
     MYLOG(OPENSEARCH_TRACE, "entering Handle=%p " FORMAT_INTEGER "," FORMAT_ULEN "\n",
           StatementHandle, Attribute, (SQLULEN)Value);
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_SetStmtAttr(StatementHandle, Attribute, Value, StringLength);
@@ -588,6 +603,8 @@ RETCODE SQL_API SQLBulkOperations(HSTMT hstmt, SQLSMALLINT operation) {
     StatementClass *stmt = (StatementClass *)hstmt;
     if (stmt == NULL)
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     SC_clear_error(stmt);
     SC_set_error(stmt, STMT_NOT_IMPLEMENTED_ERROR,
                  "Bulk operations are not supported.", "SQLBulkOperations");
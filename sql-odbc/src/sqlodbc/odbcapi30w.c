@@ -11,6 +11,7 @@
 #include "misc.h"
 #include "opensearch_apifunc.h"
 #include "opensearch_connection.h"
+#include "opensearch_statement.h"
 #include "statement.h"
 #include "unicode_support.h"
 
@@ -21,6 +22,8 @@ RETCODE SQL_API SQLGetStmtAttrW(SQLHSTMT hstmt, SQLINTEGER fAttribute,
     RETCODE ret;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending((StatementClass *)hstmt))
+        return SQL_ERROR;
     ENTER_STMT_CS((StatementClass *)hstmt);
     SC_clear_error((StatementClass *)hstmt);
     ret = OPENSEARCHAPI_GetStmtAttr(hstmt, fAttribute, rgbValue, cbValueMax, pcbValue);
@@ -34,6 +37,8 @@ RETCODE SQL_API SQLSetStmtAttrW(SQLHSTMT hstmt, SQLINTEGER fAttribute,
     StatementClass *stmt = (StatementClass *)hstmt;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     ret = OPENSEARCHAPI_SetStmtAttr(hstmt, fAttribute, rgbValue, cbValueMax);
@@ -241,6 +246,8 @@ SQLRETURN SQL_API SQLColAttributeW(SQLHSTMT hstmt, SQLUSMALLINT iCol,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     switch (iField) {
@@ -12,6 +12,7 @@
 #include "opensearch_connection.h"
 #include "opensearch_driver_connect.h"
 #include "opensearch_info.h"
+#include "opensearch_statement.h"
 #include "statement.h"
 #include "unicode_support.h"
 
@@ -33,6 +34,8 @@ RETCODE SQL_API SQLColumnsW(HSTMT StatementHandle, SQLWCHAR *CatalogName,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     ci = &(conn->connInfo);
@@ -227,6 +230,8 @@ RETCODE SQL_API SQLDescribeColW(HSTMT StatementHandle,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     buflen = 0;
     if (BufferLength > 0)
@@ -278,10 +283,19 @@ RETCODE SQL_API SQLExecDirectW(HSTMT StatementHandle, SQLWCHAR *StatementText,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    RETCODE ret = SQL_ERROR;
+    if (PollAsyncCall(stmt, SQL_API_SQLEXECDIRECT, &ret))
+        return ret;
+
     // Get query string
     SQLLEN slen = 0;
     char *stxt = ucs2_to_utf8(StatementText, TextLength, &slen, FALSE);
 
+    // The executor owns the converted text from here
+    if (SC_is_async(stmt))
+        return StartAsyncCall(stmt, SQL_API_SQLEXECDIRECT, AsyncExecDirect,
+                              stxt);
+
     // Enter critical
     ENTER_STMT_CS(stmt);
 
@@ -289,7 +303,6 @@ RETCODE SQL_API SQLExecDirectW(HSTMT StatementHandle, SQLWCHAR *StatementText,
     SC_clear_error(stmt);
 
     // Execute statement if statement is ready
-    RETCODE ret = SQL_ERROR;
     if (!SC_opencheck(stmt, "SQLExecDirectW"))
         ret = OPENSEARCHAPI_ExecDirect(StatementHandle, (const SQLCHAR *)stxt,
                                (SQLINTEGER)slen, 1);
@@ -312,6 +325,8 @@ RETCODE SQL_API SQLGetCursorNameW(HSTMT StatementHandle, SQLWCHAR *CursorName,
     SQLSMALLINT clen = 0, buflen;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     if (BufferLength > 0)
         buflen = BufferLength * 3;
     else
@@ -378,6 +393,8 @@ RETCODE SQL_API SQLPrepareW(HSTMT StatementHandle, SQLWCHAR *StatementText,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     SQLLEN slen;
     char *stxt = ucs2_to_utf8(StatementText, TextLength, &slen, FALSE);
@@ -411,6 +428,8 @@ RETCODE SQL_API SQLSetCursorNameW(HSTMT StatementHandle, SQLWCHAR *CursorName,
     SQLLEN nlen;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     crName = ucs2_to_utf8(CursorName, NameLength, &nlen, FALSE);
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
@@ -438,6 +457,8 @@ RETCODE SQL_API SQLSpecialColumnsW(
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -479,6 +500,8 @@ RETCODE SQL_API SQLStatisticsW(HSTMT StatementHandle, SQLWCHAR *CatalogName,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -521,6 +544,8 @@ RETCODE SQL_API SQLTablesW(HSTMT StatementHandle, SQLWCHAR *CatalogName,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -567,6 +592,8 @@ RETCODE SQL_API SQLColumnPrivilegesW(
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -615,6 +642,8 @@ RETCODE SQL_API SQLForeignKeysW(
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -717,6 +746,8 @@ RETCODE SQL_API SQLPrimaryKeysW(HSTMT hstmt, SQLWCHAR *szCatalogName,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -755,6 +786,8 @@ RETCODE SQL_API SQLProcedureColumnsW(
     UWORD flag = 0;
 
     MYLOG(OPENSEARCH_TRACE, "entering\n");
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
     ctName = ucs2_to_utf8(szCatalogName, cbCatalogName, &nmlen1, lower_id);
@@ -800,6 +833,8 @@ RETCODE SQL_API SQLProceduresW(HSTMT hstmt, SQLWCHAR *szCatalogName,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -844,6 +879,8 @@ RETCODE SQL_API SQLTablePrivilegesW(HSTMT hstmt, SQLWCHAR *szCatalogName,
     MYLOG(OPENSEARCH_TRACE, "entering\n");
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
 
     conn = SC_get_conn(stmt);
     lower_id = DEFAULT_LOWERCASEIDENTIFIER;
@@ -880,6 +917,8 @@ RETCODE SQL_API SQLGetTypeInfoW(SQLHSTMT StatementHandle,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     if (SC_opencheck(stmt, func))
@@ -913,6 +952,8 @@ SQLRETURN SQL_API SQLColAttributesW(SQLHSTMT hstmt, SQLUSMALLINT iCol,
     if (SC_connection_lost_check(stmt, __FUNCTION__))
         return SQL_ERROR;
 
+    if (AsyncCallPending(stmt))
+        return SQL_ERROR;
     ENTER_STMT_CS(stmt);
     SC_clear_error(stmt);
     switch (iField) {
@@ -357,7 +357,8 @@ RETCODE SQL_API OPENSEARCHAPI_GetConnectAttr(HDBC ConnectionHandle,
     MYLOG(OPENSEARCH_TRACE, "entering " FORMAT_INTEGER "\n", Attribute);
     switch (Attribute) {
         case SQL_ATTR_ASYNC_ENABLE:
-            *((SQLINTEGER *)Value) = SQL_ASYNC_ENABLE_OFF;
+            *((SQLULEN *)Value) = conn->stmtOptions.async_enable;
+            len = sizeof(SQLULEN);
             break;
         case SQL_ATTR_AUTO_IPD:
             *((SQLINTEGER *)Value) = SQL_FALSE;
@@ -1538,6 +1539,21 @@ RETCODE SQL_API OPENSEARCHAPI_GetStmtAttr(HSTMT StatementHandle, SQLINTEGER Attr
             SC_set_error(stmt, DESC_INVALID_OPTION_IDENTIFIER,
                          "Unsupported statement option (Get)", func);
             return SQL_ERROR;
+        case SQL_ATTR_ESOPT_STATEMENT_METRICS:
+            if (NULL == Value) {
+                SC_set_error(stmt, STMT_INVALID_NULL_ARG,
+                             "No buffer for the statement metrics", func);
+                return SQL_ERROR;
+            }
+            if (BufferLength < (SQLINTEGER)sizeof(OpenSearchStatementMetrics)) {
+                SC_set_error(stmt, STMT_INVALID_ARGUMENT_NO,
+                             "Buffer too small for the statement metrics",
+                             func);
+                return SQL_ERROR;
+            }
+            memcpy(Value, &stmt->metrics, sizeof(OpenSearchStatementMetrics));
+            len = sizeof(OpenSearchStatementMetrics);
+            break;
         default:
             ret = OPENSEARCHAPI_GetStmtOption(StatementHandle, (SQLSMALLINT)Attribute,
                                       Value, &len, BufferLength);
@@ -1581,7 +1597,6 @@ RETCODE SQL_API OPENSEARCHAPI_SetConnectAttr(HDBC ConnectionHandle,
             if (SQL_FALSE != Value)
                 unsupported = TRUE;
             break;
-        case SQL_ATTR_ASYNC_ENABLE:
         case SQL_ATTR_CONNECTION_DEAD:
         case SQL_ATTR_CONNECTION_TIMEOUT:
             unsupported = TRUE;
@@ -1616,6 +1631,12 @@ RETCODE SQL_API OPENSEARCHAPI_SetConnectAttr(HDBC ConnectionHandle,
                 logs_on_off(1, 0, 0);
             }
             break;
+        case SQL_ATTR_ESOPT_CLEAR_METADATA_CACHE:
+            /* Drop cached SQLTables / SQLColumns results, e.g. after the
+             * application changed an index */
+            if (conn->opensearchconn)
+                OpenSearchClearCatalogCache(conn->opensearchconn);
+            break;
         default:
             if (Attribute < 65536)
                 ret = OPENSEARCHAPI_SetConnectOption(
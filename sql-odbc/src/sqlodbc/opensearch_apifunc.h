@@ -201,7 +201,12 @@ enum {
     SQL_ATTR_ESOPT_MAXVARCHARSIZE = 65546,
     SQL_ATTR_ESOPT_MAXLONGVARCHARSIZE = 65547,
     SQL_ATTR_ESOPT_WCSDEBUG = 65548,
-    SQL_ATTR_ESOPT_MSJET = 65549
+    SQL_ATTR_ESOPT_MSJET = 65549,
+    SQL_ATTR_ESOPT_CLEAR_METADATA_CACHE = 65550
+};
+/* Driver-specific statement attributes, for SQLGetStmtAttr() */
+enum {
+    SQL_ATTR_ESOPT_STATEMENT_METRICS = 65551
 };
 RETCODE SQL_API OPENSEARCHAPI_SetConnectAttr(HDBC ConnectionHandle,
                                      SQLINTEGER Attribute, PTR Value,
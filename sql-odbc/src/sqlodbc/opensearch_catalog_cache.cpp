@@ -0,0 +1,63 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "opensearch_catalog_cache.h"
+
+// Applications only look up a few patterns, so the cache is simply emptied
+// when a misbehaving one keeps adding entries
+const size_t CATALOG_CACHE_SIZE = 1024;
+
+std::shared_ptr< const catalog_rows > OpenSearchCatalogCache::get(
+    const std::string& key, std::chrono::seconds ttl) {
+    std::scoped_lock lock(m_mutex);
+    auto found = m_entries.find(key);
+    if (found == m_entries.end()) {
+        m_metrics.misses++;
+        return nullptr;
+    }
+    if (std::chrono::steady_clock::now() - found->second.stored > ttl) {
+        m_entries.erase(found);
+        m_metrics.entries = m_entries.size();
+        m_metrics.misses++;
+        m_metrics.expiries++;
+        return nullptr;
+    }
+    m_metrics.hits++;
+    return found->second.rows;
+}
+
+void OpenSearchCatalogCache::put(const std::string& key,
+                                 std::shared_ptr< const catalog_rows > rows) {
+    std::scoped_lock lock(m_mutex);
+    if (m_entries.size() >= CATALOG_CACHE_SIZE
+        && m_entries.find(key) == m_entries.end()) {
+        m_entries.clear();
+    }
+    m_entries[key] = {std::move(rows), std::chrono::steady_clock::now()};
+    m_metrics.entries = m_entries.size();
+}
+
+void OpenSearchCatalogCache::clear(const std::string& prefix) {
+    std::scoped_lock lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_metrics.entries = m_entries.size();
+}
+
+catalog_cache_metrics OpenSearchCatalogCache::metrics() {
+    std::scoped_lock lock(m_mutex);
+    return m_metrics;
+}
+
+OpenSearchCatalogCache& SharedCatalogCache() {
+    static OpenSearchCatalogCache cache;
+    return cache;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef OPENSEARCH_CATALOG_CACHE
+#define OPENSEARCH_CATALOG_CACHE
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A column value of a catalog query, as the bytes of the C type it was bound
+// to. Character data is kept without its terminator.
+typedef struct catalog_cell {
+    bool is_null;
+    std::string data;
+} catalog_cell;
+typedef std::vector< std::vector< catalog_cell > > catalog_rows;
+
+// Counters of a catalog cache. A lookup of an entry older than the caller's
+// TTL counts as a miss and an expiry.
+typedef struct catalog_cache_metrics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t expiries = 0;
+    size_t entries = 0;
+} catalog_cache_metrics;
+
+// Rows returned by the catalog queries behind SQLTables and SQLColumns, keyed
+// by the query. Stored rows are never modified.
+class OpenSearchCatalogCache {
+    public:
+        // Returns NULL if there is no entry for key younger than ttl.
+        std::shared_ptr< const catalog_rows > get(const std::string& key,
+                                                  std::chrono::seconds ttl);
+        void put(const std::string& key,
+                 std::shared_ptr< const catalog_rows > rows);
+        // Drops the entries whose key starts with prefix.
+        void clear(const std::string& prefix = "");
+        catalog_cache_metrics metrics();
+
+    private:
+        struct Entry {
+            std::shared_ptr< const catalog_rows > rows;
+            std::chrono::steady_clock::time_point stored;
+        };
+
+        std::unordered_map< std::string, Entry > m_entries;
+        std::mutex m_mutex;
+        catalog_cache_metrics m_metrics;
+};
+
+// Catalog cache of the connections that share theirs with the process.
+OpenSearchCatalogCache& SharedCatalogCache();
+
+#endif
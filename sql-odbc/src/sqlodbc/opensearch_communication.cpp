@@ -5,14 +5,21 @@
 
 
 #include "opensearch_communication.h"
+#include "opensearch_executor.h"
+#include "opensearch_response_parser.h"
+#include "opensearch_result_cache.h"
 
 // sqlodbc needs to be included before mylog, otherwise mylog will generate
 // compiler warnings
 // clang-format off
 #include "opensearch_odbc.h"
+#include "dlg_specific.h"
 #include "mylog.h"
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <mutex>
+#include <unordered_map>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/client/RetryStrategy.h>
 #include <aws/core/client/AWSClient.h>
@@ -20,6 +27,9 @@
 #include <aws/core/auth/AWSAuthSigner.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/http/HttpClient.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif  // HAVE_ZLIB
 // clang-format on
 
 static const std::string ctype = "application/json";
@@ -96,8 +106,152 @@ static const std::string ERROR_RESPONSE_SCHEMA = R"EOF(
 )EOF";
 
 namespace {
+    /**
+     * A JSON schema compiled once and shared by every connection and cursor
+     * thread. The schema document is read only after construction, each
+     * parse call validates with its own validator.
+     */
+    class CompiledSchema {
+       public:
+        explicit CompiledSchema(const std::string& schema) {
+            m_source.Parse(schema.c_str());
+            m_schema.reset(new rapidjson::SchemaDocument(m_source));
+        }
+
+        const rapidjson::SchemaDocument& get() const {
+            return *m_schema;
+        }
+
+       private:
+        rapidjson::Document m_source;
+        std::unique_ptr< rapidjson::SchemaDocument > m_schema;
+    };
+
+    const rapidjson::SchemaDocument& QueryResponseSchema() {
+        static const CompiledSchema schema(JSON_SCHEMA);
+        return schema.get();
+    }
+
+    const rapidjson::SchemaDocument& CursorResponseSchema() {
+        static const CompiledSchema schema(CURSOR_JSON_SCHEMA);
+        return schema.get();
+    }
+
+    const rapidjson::SchemaDocument& ErrorResponseSchema() {
+        static const CompiledSchema schema(ERROR_RESPONSE_SCHEMA);
+        return schema.get();
+    }
+
+    // Unused pooled clients are dropped after this long. Server info and a
+    // passed SQL plugin check are trusted for as long.
+    const std::chrono::minutes CLIENT_POOL_IDLE_TIMEOUT(5);
+    const std::chrono::minutes SERVER_INFO_TTL(5);
+
+    /**
+     * Process wide pool of HTTP clients keyed by the settings they are built
+     * with. A client keeps its connections alive, so a new ODBC connection to
+     * the same cluster skips the TCP and TLS handshakes. The pool also caches
+     * the server info per cluster and credentials. The clients are dropped
+     * with the last connection, before the AWS SDK shuts down.
+     */
+    class HttpClientPool {
+      public:
+        std::shared_ptr< Aws::Http::HttpClient > Acquire(
+            const std::string& key,
+            const Aws::Client::ClientConfiguration& config) {
+          std::scoped_lock lock(m_mutex);
+          Purge();
+          auto it = m_clients.find(key);
+          if (it == m_clients.end()) {
+            it = m_clients
+                     .emplace(key, PooledClient{Aws::Http::CreateHttpClient(
+                                                    config),
+                                                Clock::now()})
+                     .first;
+          }
+          return it->second.client;
+        }
+
+        // Returns the client to the pool, the idle timeout starts now
+        void Release(const std::string& key,
+                     std::shared_ptr< Aws::Http::HttpClient >& client) {
+          std::scoped_lock lock(m_mutex);
+          client.reset();
+          auto it = m_clients.find(key);
+          if (it != m_clients.end()) {
+            it->second.last_used = Clock::now();
+          }
+        }
+
+        void Clear() {
+          std::unordered_map< std::string, PooledClient > clients;
+          {
+            std::scoped_lock lock(m_mutex);
+            clients.swap(m_clients);
+          }
+        }
+
+        bool GetServerInfo(const std::string& key, ServerInfo& server_info) {
+          std::scoped_lock lock(m_mutex);
+          auto it = m_server_infos.find(key);
+          if (it == m_server_infos.end()
+              || Clock::now() - it->second.fetched > SERVER_INFO_TTL) {
+            return false;
+          }
+          server_info = it->second.server_info;
+          return true;
+        }
+
+        void SetServerInfo(const std::string& key,
+                           const ServerInfo& server_info) {
+          std::scoped_lock lock(m_mutex);
+          m_server_infos[key] = CachedServerInfo{server_info, Clock::now()};
+        }
+
+      private:
+        typedef std::chrono::steady_clock Clock;
+        struct PooledClient {
+          std::shared_ptr< Aws::Http::HttpClient > client;
+          Clock::time_point last_used;
+        };
+        struct CachedServerInfo {
+          ServerInfo server_info;
+          Clock::time_point fetched;
+        };
+
+        void Purge() {
+          const Clock::time_point now = Clock::now();
+          for (auto it = m_server_infos.begin(); it != m_server_infos.end();) {
+            if (now - it->second.fetched > SERVER_INFO_TTL) {
+              it = m_server_infos.erase(it);
+            } else {
+              ++it;
+            }
+          }
+          for (auto it = m_clients.begin(); it != m_clients.end();) {
+            // Clients still held by a connection are never dropped
+            if (it->second.client.use_count() == 1
+                && now - it->second.last_used > CLIENT_POOL_IDLE_TIMEOUT) {
+              it = m_clients.erase(it);
+            } else {
+              ++it;
+            }
+          }
+        }
+
+        std::unordered_map< std::string, PooledClient > m_clients;
+        std::unordered_map< std::string, CachedServerInfo > m_server_infos;
+        std::mutex m_mutex;
+    };
+
+    HttpClientPool HTTP_CLIENT_POOL;
+
     /**
      * A helper class to initialize/shutdown AWS API once per DLL load/unload.
+     * It also owns the driver threads, those running asynchronous statements
+     * and the I/O threads fetching cursor pages. They are stopped and the
+     * pooled HTTP clients dropped with the last connection, before the SDK
+     * shuts down, rather than while the library is unloaded.
      */
     class AwsSdkHelper {
       public:
@@ -115,18 +269,323 @@ namespace {
 
         AwsSdkHelper& operator--() {
           if (0 == --m_reference_count) {
+            // Joined outside of the lock, as their last tasks may still look
+            // the executors up. The statements go first, they may start
+            // cursor fetches.
+            StopExecutor(m_driver_executor);
+            StopExecutor(m_io_executor);
+            HTTP_CLIENT_POOL.Clear();
             std::scoped_lock lock(m_mutex);
             Aws::ShutdownAPI(m_sdk_options);
           }
           return *this;
         }
 
+        // Started by the first asynchronous statement
+        OpenSearchExecutor& DriverExecutor() {
+          std::scoped_lock lock(m_mutex);
+          if (!m_driver_executor) {
+            // The statements mostly wait for the server, so there can be
+            // more of them running than there are cores
+            m_driver_executor = std::make_unique< OpenSearchExecutor >(
+                std::max(4u, 2 * std::thread::hardware_concurrency()));
+          }
+          return *m_driver_executor;
+        }
+
+        // Started by the first query paging through a cursor, with the
+        // thread count of its connection. 0 picks one from the core count.
+        // The pool is shared by the process, so a connection asking for
+        // another count is warned when check_count is set.
+        OpenSearchExecutor& IoExecutor(size_t thread_count,
+                                       bool check_count) {
+          if (thread_count == 0) {
+            thread_count =
+                std::max(4u, 2 * std::thread::hardware_concurrency());
+          }
+          std::scoped_lock lock(m_mutex);
+          if (!m_io_executor) {
+            m_io_executor =
+                std::make_unique< OpenSearchExecutor >(thread_count);
+            m_io_thread_count = thread_count;
+          } else if (check_count && thread_count != m_io_thread_count) {
+            OpenSearchCommunication::LogMsg(
+                OPENSEARCH_WARNING,
+                ("I/O thread count " + std::to_string(thread_count)
+                 + " ignored, the running pool has "
+                 + std::to_string(m_io_thread_count) + " threads.")
+                    .c_str());
+          }
+          return *m_io_executor;
+        }
+
+        void StopExecutor(std::unique_ptr< OpenSearchExecutor >& member) {
+          std::unique_ptr< OpenSearchExecutor > executor;
+          {
+            std::scoped_lock lock(m_mutex);
+            executor = std::move(member);
+          }
+          executor.reset();
+        }
+
         Aws::SDKOptions m_sdk_options;
         std::atomic<int> m_reference_count;
         std::mutex m_mutex;
+        std::unique_ptr< OpenSearchExecutor > m_driver_executor;
+        std::unique_ptr< OpenSearchExecutor > m_io_executor;
+        size_t m_io_thread_count = 0;
     };
 
     AwsSdkHelper AWS_SDK_HELPER;
+
+    // Result schemas remembered per connection for SQLPrepare and the
+    // delimited response formats, within the metadata cache TTL
+    const size_t DESCRIBE_CACHE_SIZE = 128;
+
+    /**
+     * Stream buffer the HTTP client writes response bodies into. The body is
+     * kept in a string that AwsHttpResponseToString moves out, so a page is
+     * copied once, from the client into the buffer the result owns. A body the
+     * server compressed is inflated into that string as it arrives.
+     */
+    class ResponseBodyBuffer : public std::streambuf {
+      public:
+        ResponseBodyBuffer()
+            : m_encoding(BodyEncoding::PENDING), m_wire_size(0) {
+        }
+
+        ~ResponseBodyBuffer() override {
+#ifdef HAVE_ZLIB
+          if (m_encoding == BodyEncoding::INFLATE) {
+            inflateEnd(&m_zstream);
+          }
+#endif  // HAVE_ZLIB
+        }
+
+        // Settles how the body is kept from the Content-Encoding of the
+        // response. The bytes written before are kept as they are, so it
+        // waits for the first two, which tell whether the body really is
+        // compressed and not already decoded by the HTTP client. complete is
+        // set once the whole body is in.
+        void DetectEncoding(const std::string& content_encoding,
+                            bool complete) {
+          if (m_encoding != BodyEncoding::PENDING
+              || (!complete && m_body.size() < 2)) {
+            return;
+          }
+          m_encoding = BodyEncoding::IDENTITY;
+#ifdef HAVE_ZLIB
+          if (!IsCompressed(content_encoding)) {
+            return;
+          }
+          m_zstream = z_stream();
+          // 32 lets zlib tell a gzip header from a zlib one
+          if (inflateInit2(&m_zstream, 15 + 32) != Z_OK) {
+            m_error = "Failed to initialize zlib";
+            return;
+          }
+          m_encoding = BodyEncoding::INFLATE;
+          m_inflate_status = Z_OK;
+          size_t position = GetPosition();
+          std::string compressed = std::move(m_body);
+          m_body.clear();
+          Inflate(compressed.data(), compressed.size());
+          ResetGetArea(std::min(position, m_body.size()));
+#else
+          (void)content_encoding;
+#endif  // HAVE_ZLIB
+        }
+
+        // Whole body is in, false if it could not be inflated
+        bool Finish(const std::string& content_encoding) {
+          DetectEncoding(content_encoding, true);
+#ifdef HAVE_ZLIB
+          if (m_encoding == BodyEncoding::INFLATE && m_error.empty()
+              && m_inflate_status != Z_STREAM_END) {
+            m_error = (m_inflate_status == Z_OK)
+                          ? "Compressed body is truncated"
+                          : std::string(m_zstream.msg != nullptr
+                                            ? m_zstream.msg
+                                            : "Compressed body is invalid");
+          }
+#endif  // HAVE_ZLIB
+          return m_error.empty();
+        }
+
+        bool IsInflated() const {
+          return m_encoding == BodyEncoding::INFLATE;
+        }
+
+        // Bytes received from the server, before inflating
+        size_t GetWireSize() const {
+          return IsInflated() ? m_wire_size : m_body.size();
+        }
+
+        const std::string& GetError() const {
+          return m_error;
+        }
+
+        std::string TakeBody() {
+          std::string body = std::move(m_body);
+          m_body.clear();
+          setg(nullptr, nullptr, nullptr);
+          return body;
+        }
+
+      protected:
+        int_type overflow(int_type ch) override {
+          if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+          }
+          char c = traits_type::to_char_type(ch);
+          xsputn(&c, 1);
+          return ch;
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override {
+          size_t position = GetPosition();
+#ifdef HAVE_ZLIB
+          if (m_encoding == BodyEncoding::INFLATE) {
+            Inflate(s, static_cast< size_t >(n));
+            ResetGetArea(std::min(position, m_body.size()));
+            return n;
+          }
+#endif  // HAVE_ZLIB
+          m_body.append(s, static_cast< size_t >(n));
+          ResetGetArea(position);
+          return n;
+        }
+
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override {
+          if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+          }
+          off_type base = (dir == std::ios_base::beg)
+                              ? 0
+                              : (dir == std::ios_base::cur)
+                                    ? static_cast< off_type >(GetPosition())
+                                    : static_cast< off_type >(m_body.size());
+          return seekpos(pos_type(base + off), which);
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+          off_type off = static_cast< off_type >(pos);
+          if (!(which & std::ios_base::in) || off < 0
+              || static_cast< size_t >(off) > m_body.size()) {
+            return pos_type(off_type(-1));
+          }
+          ResetGetArea(static_cast< size_t >(off));
+          return pos;
+        }
+
+      private:
+        enum class BodyEncoding { PENDING, IDENTITY, INFLATE };
+
+        size_t GetPosition() const {
+          return (eback() == nullptr) ? 0
+                                      : static_cast< size_t >(gptr() - eback());
+        }
+
+        void ResetGetArea(size_t position) {
+          char* data = &m_body[0];
+          setg(data, data + position, data + m_body.size());
+        }
+
+#ifdef HAVE_ZLIB
+        bool IsCompressed(const std::string& content_encoding) const {
+          if (m_body.size() < 2) {
+            return false;
+          }
+          unsigned char first = static_cast< unsigned char >(m_body[0]);
+          unsigned char second = static_cast< unsigned char >(m_body[1]);
+          if (content_encoding.find("gzip") != std::string::npos) {
+            return first == 0x1f && second == 0x8b;
+          }
+          if (content_encoding.find("deflate") != std::string::npos) {
+            // zlib header, 8 is the deflate method
+            return (first & 0x0f) == 8 && ((first << 8) | second) % 31 == 0;
+          }
+          return false;
+        }
+
+        // Inflates through a small chunk that stays in cache, the body grows
+        // geometrically as it is appended to
+        void Inflate(const char* data, size_t size) {
+          m_wire_size += size;
+          m_zstream.next_in =
+              reinterpret_cast< Bytef* >(const_cast< char* >(data));
+          m_zstream.avail_in = static_cast< uInt >(size);
+          // A full chunk may leave output behind in zlib, so it is called
+          // again until it has nothing more
+          while (m_inflate_status == Z_OK
+                 && (m_zstream.avail_in > 0 || m_zstream.avail_out == 0)) {
+            m_zstream.next_out = m_chunk;
+            m_zstream.avail_out = sizeof(m_chunk);
+            int status = inflate(&m_zstream, Z_NO_FLUSH);
+            m_body.append(reinterpret_cast< const char* >(m_chunk),
+                          sizeof(m_chunk) - m_zstream.avail_out);
+            if (status == Z_BUF_ERROR) {
+              break;
+            }
+            m_inflate_status = status;
+          }
+        }
+
+        z_stream m_zstream;
+        Bytef m_chunk[16 * 1024];
+        int m_inflate_status;
+#endif  // HAVE_ZLIB
+        BodyEncoding m_encoding;
+        size_t m_wire_size;
+        std::string m_error;
+        std::string m_body;
+    };
+
+    class ResponseBodyStream : public Aws::IOStream {
+      public:
+        ResponseBodyStream() : Aws::IOStream(&m_buffer) {
+        }
+
+        ResponseBodyBuffer& GetBuffer() {
+          return m_buffer;
+        }
+
+      private:
+        ResponseBodyBuffer m_buffer;
+    };
+
+    Aws::IOStream* CreateResponseBodyStream() {
+      return Aws::New< ResponseBodyStream >(ALLOCATION_TAG.c_str());
+    }
+
+    std::string GetContentEncoding(const Aws::Http::HttpResponse& response) {
+      return response.HasHeader("content-encoding")
+                 ? std::string(response.GetHeader("content-encoding"))
+                 : std::string();
+    }
+
+    std::shared_ptr< ErrorDetails > NewErrorDetails(
+        const std::string& reason, const std::string& message,
+        ConnErrorType error_type) {
+        auto error_details = std::make_shared< ErrorDetails >();
+        error_details->reason = reason;
+        error_details->details = message;
+        error_details->source_type = "Dummy type";
+        error_details->type = error_type;
+        return error_details;
+    }
+
+    // The message reported to the application for an error
+    std::string FormatErrorDetails(const ErrorDetails& error_details) {
+        return ERROR_MSG_PREFIX + error_details.reason + ": "
+               + std::regex_replace(error_details.details, std::regex("\\n"),
+                                    "\\\\n");
+    }
+}
+
+OpenSearchExecutor& DriverExecutor() {
+    return AWS_SDK_HELPER.DriverExecutor();
 }
 
 void OpenSearchCommunication::AwsHttpResponseToString(
@@ -136,28 +595,53 @@ void OpenSearchCommunication::AwsHttpResponseToString(
     // ways (using stringstream operators) takes ~30x longer than this code
     // below and bottlenecks our query performance
 
+    // Bodies written by IssueRequest already sit in a string we can take
+    ResponseBodyStream* body_stream =
+        dynamic_cast< ResponseBodyStream* >(&response->GetResponseBody());
+    if (body_stream != nullptr) {
+        ResponseBodyBuffer& body = body_stream->GetBuffer();
+        if (!body.Finish(GetContentEncoding(*response))) {
+            LogMsg(OPENSEARCH_ERROR,
+                   ("Failed to inflate response body: " + body.GetError())
+                       .c_str());
+        }
+        size_t wire_size = body.GetWireSize();
+        bool inflated = body.IsInflated();
+        output = body.TakeBody();
+        if (inflated) {
+            LogMsg(OPENSEARCH_DEBUG,
+                   ("Response body inflated from "
+                    + std::to_string(wire_size) + " to "
+                    + std::to_string(output.size()) + " bytes.")
+                       .c_str());
+        }
+        return;
+    }
+
     // Get streambuffer from response and set position to start
     std::streambuf* stream_buffer = response->GetResponseBody().rdbuf();
     stream_buffer->pubseekpos(0);
 
-    // Get size of streambuffer and reserver that much space in the output
-    size_t avail = static_cast< size_t >(stream_buffer->in_avail());
-    std::vector< char > buf(avail, '\0');
-    output.clear();
-    output.reserve(avail);
-
     // Directly copy memory from buffer into our string buffer
-    stream_buffer->sgetn(buf.data(), avail);
-    output.assign(buf.data(), avail);
+    size_t avail = static_cast< size_t >(stream_buffer->in_avail());
+    output.resize(avail);
+    stream_buffer->sgetn(&output[0], avail);
 }
 
-void OpenSearchCommunication::PrepareCursorResult(OpenSearchResult& opensearch_result) {
+void OpenSearchCommunication::PrepareCursorResult(
+    OpenSearchResult& opensearch_result, bool validate) {
     // Prepare document and validate result
     try {
-        LogMsg(OPENSEARCH_DEBUG, "Parsing result JSON with cursor.");
-        opensearch_result.opensearch_result_doc.parse(
-            opensearch_result.result_json,
-                                      CURSOR_JSON_SCHEMA);
+        if (validate) {
+            LogMsg(OPENSEARCH_DEBUG, "Parsing result JSON with cursor.");
+            opensearch_result.opensearch_result_doc.parse(
+                opensearch_result.result_json, CursorResponseSchema());
+        } else {
+            LogMsg(OPENSEARCH_DEBUG,
+                   "Parsing result JSON with cursor (no schema validation).");
+            opensearch_result.opensearch_result_doc.parse(
+                opensearch_result.result_json);
+        }
     } catch (const rabbit::parse_error& e) {
         // The exception rabbit gives is quite useless - providing the json
         // will aid debugging for users
@@ -174,8 +658,7 @@ std::shared_ptr< ErrorDetails > OpenSearchCommunication::ParseErrorResponse(
     try {
         LogMsg(OPENSEARCH_DEBUG, "Parsing error response (with schema validation)");
         opensearch_result.opensearch_result_doc.parse(
-            opensearch_result.result_json,
-                                      ERROR_RESPONSE_SCHEMA);
+            opensearch_result.result_json, ErrorResponseSchema());
 
         auto error_details = std::make_shared< ErrorDetails >();
         error_details->reason =
@@ -197,13 +680,7 @@ std::shared_ptr< ErrorDetails > OpenSearchCommunication::ParseErrorResponse(
 
 void OpenSearchCommunication::SetErrorDetails(std::string reason, std::string message,
                                       ConnErrorType error_type) {
-    // Prepare document and validate schema
-    auto error_details = std::make_shared< ErrorDetails >();
-    error_details->reason = reason;
-    error_details->details = message;
-    error_details->source_type = "Dummy type";
-    error_details->type = error_type;
-    m_error_details = error_details;
+    m_error_details = NewErrorDetails(reason, message, error_type);
 }
 
 void OpenSearchCommunication::SetErrorDetails(ErrorDetails details) {
@@ -217,7 +694,7 @@ void OpenSearchCommunication::GetJsonSchema(OpenSearchResult& opensearch_result)
     try {
         LogMsg(OPENSEARCH_DEBUG, "Parsing result JSON with schema.");
         opensearch_result.opensearch_result_doc.parse(
-            opensearch_result.result_json, JSON_SCHEMA);
+            opensearch_result.result_json, QueryResponseSchema());
     } catch (const rabbit::parse_error& e) {
         // The exception rabbit gives is quite useless - providing the json
         // will aid debugging for users
@@ -228,6 +705,153 @@ void OpenSearchCommunication::GetJsonSchema(OpenSearchResult& opensearch_result)
     }
 }
 
+OpenSearchResultStream::OpenSearchResultStream(size_t prefetch_depth)
+    : m_prefetch_depth(prefetch_depth),
+      m_result_queue(std::make_unique< OpenSearchResultQueue >(
+          static_cast< unsigned int >(prefetch_depth))),
+      m_is_retrieving(false),
+      m_cursor_page_validated(false),
+      m_request_generation(0),
+      m_conn(nullptr),
+      m_replay_next(0),
+      m_tasks(0),
+      m_fetching(false),
+      m_pages_ahead(0),
+      m_next_fetch(0),
+      m_next_publish(0),
+      m_failed_page(SIZE_MAX),
+      m_http_time_us(0),
+      m_bytes_received(0),
+      m_parse_time_us(0),
+      m_pages_fetched(0),
+      m_sign_time_us(0),
+      m_cache_bytes(0) {
+}
+
+OpenSearchResultStream::~OpenSearchResultStream() {
+    StopRetrieval();
+}
+
+void OpenSearchResultStream::SetPrefetchDepth(size_t prefetch_depth) {
+    if (prefetch_depth != m_prefetch_depth) {
+        m_prefetch_depth = prefetch_depth;
+        m_result_queue = std::make_unique< OpenSearchResultQueue >(
+            static_cast< unsigned int >(m_prefetch_depth));
+    }
+}
+
+void OpenSearchResultStream::StopRetrieval() {
+    std::string cursor;
+    {
+        std::unique_lock< std::mutex > lock(m_retrieval_mutex);
+        if (m_is_retrieving) {
+            m_is_retrieving = false;
+            CancelRequests();
+            m_result_queue->cancel();
+        }
+        // The tasks still running reference this stream and its connection
+        m_tasks_done.wait(lock, [this]() { return m_tasks == 0; });
+        cursor = std::move(m_cursor);
+        m_cursor.clear();
+        m_replay_pages.reset();
+        m_decoded.clear();
+        // Pages the statement did not pop belong to the stopped query, even
+        // when all of them were fetched before it stopped
+        m_result_queue->clear();
+    }
+
+    // The statement let go of the result before its last page, free the
+    // scroll context on the server instead of waiting for it to expire
+    if (!cursor.empty()) {
+        m_conn->SendCloseCursorRequest(cursor, this);
+    }
+}
+
+void OpenSearchResultStream::CancelRequests() {
+    ++m_request_generation;
+}
+
+OpenSearchResult* OpenSearchResultStream::PopResult() {
+    OpenSearchResult* result = NULL;
+    if (!m_result_queue->try_pop(result)) {
+        // The consumer caught up with the prefetch pipeline
+        auto start = std::chrono::steady_clock::now();
+        if (m_result_queue->pop(result)) {
+            m_prefetch_metrics.pop_stalls++;
+            m_prefetch_metrics.stall_time_us +=
+                std::chrono::duration_cast< std::chrono::microseconds >(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+        }
+    }
+
+    if (result != NULL) {
+        m_prefetch_metrics.pages_popped++;
+        // The page left room for one more to be fetched
+        std::scoped_lock lock(m_retrieval_mutex);
+        if (m_pages_ahead > 0) {
+            m_pages_ahead--;
+        }
+        if (m_is_retrieving) {
+            m_conn->ScheduleCursorFetch(*this);
+        }
+    } else if (m_prefetch_metrics.pages_popped > 1) {
+        std::string msg =
+            "Prefetch: " + std::to_string(m_prefetch_metrics.pages_popped)
+            + " pages, " + std::to_string(m_prefetch_metrics.pop_stalls)
+            + " stalls, "
+            + std::to_string(m_prefetch_metrics.stall_time_us / 1000)
+            + " ms waiting (depth " + std::to_string(m_prefetch_depth) + ").";
+        OpenSearchCommunication::LogMsg(OPENSEARCH_DEBUG, msg.c_str());
+    }
+
+    return result;
+}
+
+prefetch_metrics OpenSearchResultStream::GetPrefetchMetrics() {
+    return m_prefetch_metrics;
+}
+
+std::string OpenSearchResultStream::GetErrorMessage() {
+    std::scoped_lock lock(m_error_mutex);
+    return m_error_details ? FormatErrorDetails(*m_error_details)
+                           : std::string();
+}
+
+ConnErrorType OpenSearchResultStream::GetErrorType() {
+    std::scoped_lock lock(m_error_mutex);
+    return m_error_details ? m_error_details->type
+                           : ConnErrorType::CONN_ERROR_SUCCESS;
+}
+
+void OpenSearchResultStream::SetError(std::shared_ptr< ErrorDetails > details) {
+    std::scoped_lock lock(m_error_mutex);
+    m_error_details = std::move(details);
+}
+
+void OpenSearchResultStream::ClearError() {
+    std::scoped_lock lock(m_error_mutex);
+    m_error_details.reset();
+}
+
+query_metrics OpenSearchResultStream::GetQueryMetrics() {
+    query_metrics metrics;
+    metrics.http_time_us = m_http_time_us;
+    metrics.bytes_received = m_bytes_received;
+    metrics.parse_time_us = m_parse_time_us;
+    metrics.pages_fetched = m_pages_fetched;
+    metrics.sign_time_us = m_sign_time_us;
+    return metrics;
+}
+
+void OpenSearchResultStream::ResetQueryMetrics() {
+    m_http_time_us = 0;
+    m_bytes_received = 0;
+    m_parse_time_us = 0;
+    m_pages_fetched = 0;
+    m_sign_time_us = 0;
+}
+
 OpenSearchCommunication::OpenSearchCommunication()
 #ifdef __APPLE__
 #pragma clang diagnostic push
@@ -236,11 +860,20 @@ OpenSearchCommunication::OpenSearchCommunication()
     : m_status(ConnStatusType::CONNECTION_BAD),
       m_error_type(ConnErrorType::CONN_ERROR_SUCCESS),
       m_valid_connection_options(false),
-      m_is_retrieving(false),
       m_error_message(""),
-      m_result_queue(2),
+      m_prefetch_depth(DEFAULT_PREFETCH_DEPTH),
+      m_io_threads(DEFAULT_IO_THREADS),
+      m_io_threads_checked(false),
+      m_flat_separator('\0'),
+      m_query_cache_ttl(DEFAULT_QUERY_CACHE_TTL),
+      m_query_cache_budget(DEFAULT_QUERY_CACHE_SIZE * 1024 * 1024),
+      m_metadata_cache_ttl(DEFAULT_METADATA_CACHE_TTL),
+      m_stream(DEFAULT_PREFETCH_DEPTH),
       m_client_encoding(m_supported_client_encodings[0]),
-      m_error_message_to_user("")
+      m_error_message_to_user(""),
+      m_has_server_info(false),
+      m_request_count(0),
+      m_request_generation(0)
 #ifdef __APPLE__
 #pragma clang diagnostic pop
 #endif  // __APPLE__
@@ -249,16 +882,22 @@ OpenSearchCommunication::OpenSearchCommunication()
 }
 
 OpenSearchCommunication::~OpenSearchCommunication() {
+    StopResultRetrieval();
+    if (m_http_client) {
+        HTTP_CLIENT_POOL.Release(m_client_key, m_http_client);
+    }
     --AWS_SDK_HELPER;
 }
 
 std::string OpenSearchCommunication::GetErrorMessage() {
+    // The last query run on the stream of the connection failed
+    std::string stream_error = m_stream.GetErrorMessage();
+    if (!stream_error.empty()) {
+        return stream_error;
+    }
     // TODO #35 - Check if they expect NULL or "" when there is no error.
     if (m_error_details) {
-        m_error_details->details = std::regex_replace(
-            m_error_details->details, std::regex("\\n"), "\\\\n");
-        return ERROR_MSG_PREFIX + m_error_details->reason + ": "
-               + m_error_details->details;
+        return FormatErrorDetails(*m_error_details);
     } else {
         return ERROR_MSG_PREFIX
                + "No error details available; check the driver logs.";
@@ -266,6 +905,9 @@ std::string OpenSearchCommunication::GetErrorMessage() {
 }
 
 ConnErrorType OpenSearchCommunication::GetErrorType() {
+    if (!m_stream.GetErrorMessage().empty()) {
+        return m_stream.GetErrorType();
+    }
     return m_error_type;
 }
 
@@ -276,9 +918,100 @@ bool OpenSearchCommunication::ConnectionOptions(runtime_options& rt_opts,
     (void)(option_count);
     (void)(use_defaults);
     m_rt_opts = rt_opts;
+    m_has_server_info = false;
+
+    size_t prefetch_depth =
+        ReadCountOption(m_rt_opts.conn.prefetch_depth, DEFAULT_PREFETCH_DEPTH,
+                        1, "prefetch depth");
+    m_query_cache_ttl = std::chrono::seconds(
+        ReadCountOption(m_rt_opts.conn.query_cache_ttl,
+                        DEFAULT_QUERY_CACHE_TTL, 0, "query cache TTL"));
+    m_query_cache_budget =
+        ReadCountOption(m_rt_opts.conn.query_cache_size,
+                        DEFAULT_QUERY_CACHE_SIZE, 0, "query cache size")
+        * 1024 * 1024;
+    m_metadata_cache_ttl = std::chrono::seconds(
+        ReadCountOption(m_rt_opts.conn.metadata_cache_ttl,
+                        DEFAULT_METADATA_CACHE_TTL, 0, "metadata cache TTL"));
+    m_io_threads = ReadCountOption(m_rt_opts.conn.io_threads,
+                                   DEFAULT_IO_THREADS, 0, "I/O thread count");
+    m_io_threads_checked = false;
+    std::string response_format = m_rt_opts.conn.response_format;
+    std::transform(response_format.begin(), response_format.end(),
+                   response_format.begin(), ::tolower);
+    m_flat_separator = '\0';
+    m_flat_format_params.clear();
+    if (response_format == "csv") {
+        // Unsanitized, so negative numbers are not prefixed with a quote
+        m_flat_separator = ',';
+        m_flat_format_params = "?format=csv&sanitize=false";
+    } else if (response_format == "raw") {
+        m_flat_separator = '|';
+        m_flat_format_params = "?format=raw";
+    } else if (!response_format.empty() && response_format != "jdbc") {
+        LogMsg(OPENSEARCH_WARNING,
+               ("Invalid response format '" + m_rt_opts.conn.response_format
+                + "', using jdbc.")
+                   .c_str());
+    }
+#ifndef HAVE_ZLIB
+    if (m_rt_opts.conn.compression) {
+        LogMsg(OPENSEARCH_WARNING,
+               "Compression is not supported by this build of the driver.");
+        m_rt_opts.conn.compression = false;
+    }
+#endif  // HAVE_ZLIB
+    m_prefetch_depth = prefetch_depth;
+    m_stream.SetPrefetchDepth(m_prefetch_depth);
+    InitializeAuthentication();
     return CheckConnectionOptions();
 }
 
+size_t OpenSearchCommunication::ReadCountOption(const std::string& value,
+                                                size_t default_value,
+                                                size_t minimum,
+                                                const std::string& name) {
+    if (value.empty()) {
+        return default_value;
+    }
+    try {
+        long count = std::stol(value);
+        if (count < static_cast< long >(minimum)) {
+            throw std::out_of_range(name + " is too small");
+        }
+        return static_cast< size_t >(count);
+    } catch (std::exception&) {
+        LogMsg(OPENSEARCH_WARNING,
+               ("Invalid " + name + " '" + value + "', using default.").c_str());
+    }
+    return default_value;
+}
+
+void OpenSearchCommunication::InitializeAuthentication() {
+    m_basic_authorization.clear();
+    m_signer.reset();
+    if (m_rt_opts.auth.auth_type == AUTHTYPE_BASIC) {
+        std::string userpw_str =
+            m_rt_opts.auth.username + ":" + m_rt_opts.auth.password;
+        Aws::Utils::Array< unsigned char > userpw_arr(
+            reinterpret_cast< const unsigned char* >(userpw_str.c_str()),
+            userpw_str.length());
+        m_basic_authorization =
+            "Basic "
+            + std::string(Aws::Utils::HashingUtils::Base64Encode(userpw_arr));
+    } else if (m_rt_opts.auth.auth_type == AUTHTYPE_IAM) {
+        // The provider reads the profile files on first use and again once
+        // its credentials are older than its refresh interval
+        std::shared_ptr< Aws::Auth::ProfileConfigFileAWSCredentialsProvider >
+            credential_provider = Aws::MakeShared<
+                Aws::Auth::ProfileConfigFileAWSCredentialsProvider >(
+                ALLOCATION_TAG.c_str(), ESODBC_PROFILE_NAME.c_str());
+        m_signer = Aws::MakeShared< Aws::Client::AWSAuthV4Signer >(
+            ALLOCATION_TAG.c_str(), credential_provider, SERVICE_NAME.c_str(),
+            m_rt_opts.auth.region.c_str());
+    }
+}
+
 bool OpenSearchCommunication::ConnectionOptions2() {
     return true;
 }
@@ -286,6 +1019,8 @@ bool OpenSearchCommunication::ConnectionOptions2() {
 bool OpenSearchCommunication::ConnectDBStart() {
     LogMsg(OPENSEARCH_ALL, "Starting DB connection.");
     m_status = ConnStatusType::CONNECTION_BAD;
+    const auto start = std::chrono::steady_clock::now();
+    const size_t start_requests = m_request_count;
     if (!m_valid_connection_options) {
         // TODO: get error message from CheckConnectionOptions
         m_error_message =
@@ -309,7 +1044,16 @@ bool OpenSearchCommunication::ConnectDBStart() {
         return false;
     }
 
-    LogMsg(OPENSEARCH_DEBUG, "Connection established.");
+    m_connect_metrics.connect_time_us =
+        std::chrono::duration_cast< std::chrono::microseconds >(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    m_connect_metrics.requests = m_request_count - start_requests;
+    std::string msg =
+        "Connection established in "
+        + std::to_string(m_connect_metrics.connect_time_us / 1000) + " ms with "
+        + std::to_string(m_connect_metrics.requests) + " requests.";
+    LogMsg(OPENSEARCH_DEBUG, msg.c_str());
     m_status = ConnStatusType::CONNECTION_OK;
     return true;
 }
@@ -321,7 +1065,7 @@ ConnStatusType OpenSearchCommunication::GetConnectionStatus() {
 void OpenSearchCommunication::DropDBConnection() {
     LogMsg(OPENSEARCH_ALL, "Dropping DB connection.");
     if (m_http_client) {
-        m_http_client.reset();
+        HTTP_CLIENT_POOL.Release(m_client_key, m_http_client);
     }
 
     m_status = ConnStatusType::CONNECTION_BAD;
@@ -379,14 +1123,28 @@ void OpenSearchCommunication::InitializeConnection() {
     config.connectTimeoutMs = response_timeout;
     config.httpRequestTimeoutMs = response_timeout;
     config.requestTimeoutMs = response_timeout;
-    m_http_client = Aws::Http::CreateHttpClient(config);
+    config.enableTcpKeepAlive = true;
+
+    // Requests are authenticated one by one, so the client itself can be
+    // shared by any connection with the same transport settings. Cached
+    // server info also vouches for the credentials, through the plugin check.
+    m_client_key = m_rt_opts.conn.server + "|" + m_rt_opts.conn.port + "|"
+                   + (m_rt_opts.crypt.use_ssl ? "1" : "0")
+                   + (m_rt_opts.crypt.verify_server ? "1" : "0") + "|"
+                   + std::to_string(response_timeout);
+    m_server_info_key =
+        m_client_key + "|" + m_rt_opts.auth.auth_type + "|"
+        + m_rt_opts.auth.region + "|" + m_rt_opts.auth.username + "|"
+        + std::to_string(std::hash< std::string >()(m_rt_opts.auth.password));
+    m_http_client = HTTP_CLIENT_POOL.Acquire(m_client_key, config);
 }
 
 std::shared_ptr< Aws::Http::HttpResponse >
 OpenSearchCommunication::IssueRequest(
     const std::string& endpoint, const Aws::Http::HttpMethod request_type,
     const std::string& content_type, const std::string& query,
-    const std::string& fetch_size, const std::string& cursor) {
+    const std::string& fetch_size, const std::string& cursor,
+    OpenSearchResultStream* stream) {
     // Generate http request
     std::shared_ptr< Aws::Http::HttpRequest > request =
         Aws::Http::CreateHttpRequest(
@@ -394,13 +1152,29 @@ OpenSearchCommunication::IssueRequest(
                 m_rt_opts.conn.server
                 + (m_rt_opts.conn.port.empty() ? "" : ":" + m_rt_opts.conn.port)
                 + endpoint),
-            request_type,
-            Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+            request_type, CreateResponseBodyStream);
 
     // Set header type
     if (!content_type.empty())
         request->SetHeaderValue(Aws::Http::CONTENT_TYPE_HEADER, ctype);
 
+    // The encoding is read once the first bytes of the body are in, so the
+    // rest of it is inflated as it arrives
+    if (m_rt_opts.conn.compression) {
+        request->SetAcceptEncoding("gzip, deflate");
+        request->SetDataReceivedEventHandler(
+            [](const Aws::Http::HttpRequest*, Aws::Http::HttpResponse* response,
+               long long) {
+                ResponseBodyStream* body_stream =
+                    dynamic_cast< ResponseBodyStream* >(
+                        &response->GetResponseBody());
+                if (body_stream != nullptr) {
+                    body_stream->GetBuffer().DetectEncoding(
+                        GetContentEncoding(*response), false);
+                }
+            });
+    }
+
     // Set body
     if (!query.empty() || !cursor.empty()) {
         rabbit::object body;
@@ -419,28 +1193,42 @@ OpenSearchCommunication::IssueRequest(
     }
 
     // Handle authentication
-    if (m_rt_opts.auth.auth_type == AUTHTYPE_BASIC) {
-        std::string userpw_str =
-            m_rt_opts.auth.username + ":" + m_rt_opts.auth.password;
-        Aws::Utils::Array< unsigned char > userpw_arr(
-            reinterpret_cast< const unsigned char* >(userpw_str.c_str()),
-            userpw_str.length());
-        std::string hashed_userpw =
-            Aws::Utils::HashingUtils::Base64Encode(userpw_arr);
-        request->SetAuthorization("Basic " + hashed_userpw);
-    } else if (m_rt_opts.auth.auth_type == AUTHTYPE_IAM) {
-        std::shared_ptr< Aws::Auth::ProfileConfigFileAWSCredentialsProvider >
-            credential_provider = Aws::MakeShared<
-                Aws::Auth::ProfileConfigFileAWSCredentialsProvider >(
-                ALLOCATION_TAG.c_str(), ESODBC_PROFILE_NAME.c_str());
-        Aws::Client::AWSAuthV4Signer signer(credential_provider,
-                                            SERVICE_NAME.c_str(),
-                                            m_rt_opts.auth.region.c_str());
-        signer.SignRequest(*request);
+    auto sign_start = std::chrono::steady_clock::now();
+    if (!m_basic_authorization.empty()) {
+        request->SetAuthorization(m_basic_authorization);
+    } else if (m_signer) {
+        m_signer->SignRequest(*request);
+    }
+    if (stream != nullptr) {
+        stream->m_sign_time_us +=
+            std::chrono::duration_cast< std::chrono::microseconds >(
+                std::chrono::steady_clock::now() - sign_start)
+                .count();
     }
 
+    // The request is aborted once CancelRequests of the connection or the
+    // stream is called, even while the response is being received
+    std::atomic< size_t >& request_generation =
+        stream ? stream->m_request_generation : m_request_generation;
+    const size_t generation = request_generation;
+    request->SetContinueRequestHandle(
+        [&request_generation, generation](const Aws::Http::HttpRequest*) {
+            return generation == request_generation;
+        });
+
     // Issue request and return response
-    return m_http_client->MakeRequest(request);
+    ++m_request_count;
+    if (stream == nullptr) {
+        return m_http_client->MakeRequest(request);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr< Aws::Http::HttpResponse > response =
+        m_http_client->MakeRequest(request);
+    stream->m_http_time_us +=
+        std::chrono::duration_cast< std::chrono::microseconds >(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    return response;
 }
 
 bool OpenSearchCommunication::IsSQLPluginEnabled(std::shared_ptr< ErrorDetails > error_details) {
@@ -473,9 +1261,10 @@ bool OpenSearchCommunication::CheckSQLPluginAvailability() {
             return true;
         }
         else {
+            // The body was taken above, parse the copy
             std::unique_ptr< OpenSearchResult > result =
                 std::make_unique< OpenSearchResult >();
-            AwsHttpResponseToString(response, result->result_json);
+            result->result_json = m_response_str;
             std::shared_ptr< ErrorDetails > error_details =
                 ParseErrorResponse(*result);
 
@@ -524,6 +1313,15 @@ bool OpenSearchCommunication::EstablishConnection() {
         InitializeConnection();
     }
 
+    // A recent connection with the same settings already read the root
+    // endpoint and passed the plugin check
+    if (HTTP_CLIENT_POOL.GetServerInfo(m_server_info_key, m_server_info)) {
+        LogMsg(OPENSEARCH_DEBUG, "Using cached server info.");
+        m_has_server_info = true;
+        SetSqlEndpoint();
+        return true;
+    }
+
     // check if the endpoint is initialized
     if (sql_endpoint.empty()) {
         SetSqlEndpoint();
@@ -533,6 +1331,9 @@ bool OpenSearchCommunication::EstablishConnection() {
     // OpenSearch server since the SQL plugin is a prerequisite to
     // use this driver.
     if(CheckSQLPluginAvailability()) {
+        if (m_has_server_info) {
+            HTTP_CLIENT_POOL.SetServerInfo(m_server_info_key, m_server_info);
+        }
         return true;
     }
 
@@ -541,12 +1342,11 @@ bool OpenSearchCommunication::EstablishConnection() {
 }
 
 std::vector< std::string > OpenSearchCommunication::GetColumnsWithSelectQuery(
-    const std::string table_name) {
+    OpenSearchResultStream& stream, const std::string table_name) {
     std::vector< std::string > list_of_column;
     if (table_name.empty()) {
-        m_error_type = ConnErrorType::CONN_ERROR_INVALID_NULL_PTR;
-        m_error_message = "Query is NULL";
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
+        SetQueryError(stream, "Execution error", "Query is NULL",
+                      ConnErrorType::CONN_ERROR_INVALID_NULL_PTR);
         return list_of_column;
     }
 
@@ -558,16 +1358,14 @@ std::vector< std::string > OpenSearchCommunication::GetColumnsWithSelectQuery(
     // Issue request
     std::shared_ptr< Aws::Http::HttpResponse > response =
         IssueRequest(sql_endpoint, Aws::Http::HttpMethod::HTTP_POST,
-                     ctype, query);
+                     ctype, query, "", "", &stream);
 
     // Validate response
     if (response == nullptr) {
-        m_error_message =
-            "Failed to receive response from query. "
-            "Received NULL response.";
-        SetErrorDetails("HTTP client error", m_error_message,
-                        ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
+        SetQueryError(stream, "HTTP client error",
+                      "Failed to receive response from query. "
+                      "Received NULL response.",
+                      ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
         return list_of_column;
     }
 
@@ -577,212 +1375,611 @@ std::vector< std::string > OpenSearchCommunication::GetColumnsWithSelectQuery(
 
     // If response was not valid, set error
     if (response->GetResponseCode() != Aws::Http::HttpResponseCode::OK) {
-        m_error_type = ConnErrorType::CONN_ERROR_QUERY_SYNTAX;
-        m_error_message =
+        std::string error_message =
             "Http response code was not OK. Code received: "
             + std::to_string(static_cast< long >(response->GetResponseCode()))
             + ".";
         if (response->HasClientError())
-            m_error_message +=
+            error_message +=
                 " Client error: '" + response->GetClientErrorMessage() + "'.";
         if (!result->result_json.empty()) {
-            m_error_message +=
+            error_message +=
                 " Response error: '" + result->result_json + "'.";
         }
-        SetErrorDetails("Connection error", m_error_message,
-                        ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
+        SetQueryError(stream, "Connection error", error_message,
+                      ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
         return list_of_column;
     }
 
-    GetJsonSchema(*result);
-
-    rabbit::array schema_array = result->opensearch_result_doc["schema"];
-    for (rabbit::array::iterator it = schema_array.begin();
-         it != schema_array.end(); ++it) {
-        std::string column_name = it->at("name").as_string();
-        list_of_column.push_back(column_name);
+    ConstructOpenSearchResult(*result);
+    for (auto& it : result->column_info) {
+        list_of_column.push_back(it.field_name);
     }
 
     return list_of_column;
 }
 
 int OpenSearchCommunication::ExecDirect(const char* query, const char* fetch_size_) {
-    m_error_details.reset();
-    if (!query) {
-        m_error_message = "Query is NULL";
-        SetErrorDetails("Execution error", m_error_message,
-                        ConnErrorType::CONN_ERROR_INVALID_NULL_PTR);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
+    return ExecDirect(m_stream, query, fetch_size_);
+}
+
+int OpenSearchCommunication::ExecDirect(OpenSearchResultStream& stream,
+                                        const char* query,
+                                        const char* fetch_size_) {
+    stream.ClearError();
+    if (!CheckQuery(stream, query)) {
         return -1;
-    } else if (!m_http_client) {
-        m_error_message = "Unable to connect. Please try connecting again.";
-        SetErrorDetails("Execution error", m_error_message,
-                        ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
+    }
+
+    // The pages of a previous query are no longer wanted
+    stream.StopRetrieval();
+    stream.SetPrefetchDepth(m_prefetch_depth);
+    stream.ResetQueryMetrics();
+
+    // Results that are not paged can come as delimited text
+    const bool flat = m_flat_separator != '\0'
+                      && !m_rt_opts.conn.use_dom_parser
+                      && std::atol(fetch_size_) <= 0;
+
+    std::string cache_key;
+    stream.m_cache_pages.reset();
+    if (m_query_cache_ttl.count() > 0 && !m_rt_opts.conn.use_dom_parser) {
+        cache_key = m_server_info_key + "|" + fetch_size_ + "|"
+                    + (flat ? m_flat_format_params : "") + "|"
+                    + NormalizeStatement(query);
+        std::shared_ptr< const OpenSearchResultCache::Pages > pages =
+            QueryResultCache().get(cache_key, m_query_cache_ttl);
+        if (pages) {
+            return ReplayCachedResult(stream, pages);
+        }
+    }
+
+    const size_t generation = stream.m_request_generation;
+    std::unique_ptr< OpenSearchResult > result = ExecuteQuery(
+        std::string(query), std::string(fetch_size_), stream, flat);
+    if (generation != stream.m_request_generation) {
+        if (result && !result->cursor.empty()) {
+            SendCloseCursorRequest(result->cursor, &stream);
+        }
+        stream.SetError(NewErrorDetails(
+            "Execution error", "Query was cancelled.",
+            ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE));
+        LogMsg(OPENSEARCH_DEBUG, "Query was cancelled.");
+        return -1;
+    }
+    if (!result) {
         return -1;
     }
 
-    // Prepare statement
-    std::string statement(query);
-    std::string fetch_size(fetch_size_);
+    // Record the pages as they are handed out, a complete result is cached
+    if (!cache_key.empty()) {
+        stream.m_cache_key = cache_key;
+        stream.m_cache_bytes = 0;
+        stream.m_cache_pages =
+            std::make_shared< OpenSearchResultCache::Pages >();
+        RecordCachedPage(stream, *result);
+    }
+
+    // Add to result queue and return
+    const std::string cursor = result->cursor;
+    return StartRetrieval(stream, std::move(result), cursor, nullptr);
+}
+
+OpenSearchResult* OpenSearchCommunication::DescribeQuery(
+    OpenSearchResultStream& stream, const char* query) {
+    stream.ClearError();
+    if (!CheckQuery(stream, query)) {
+        return NULL;
+    }
+
+    // A schema without rows, in the layout the streaming parser produces
+    std::unique_ptr< OpenSearchResult > result =
+        std::make_unique< OpenSearchResult >();
+    if (!ProbeSchema(std::string(query), result->schema, stream)) {
+        return NULL;
+    }
+    result->streamed = true;
+    std::vector< std::string > column_names;
+    for (auto& it : result->schema) {
+        column_names.push_back(it.first);
+    }
+    SetColumnInfo(*result, column_names);
+    return result.release();
+}
+
+bool OpenSearchCommunication::ProbeSchema(
+    const std::string& statement,
+    std::vector< std::pair< std::string, std::string > >& schema,
+    OpenSearchResultStream& stream) {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_metadata_cache_ttl.count() != 0) {
+        std::scoped_lock lock(m_describe_mutex);
+        auto cached = m_describe_cache.find(statement);
+        if (cached != m_describe_cache.end()) {
+            if (now - cached->second.described <= m_metadata_cache_ttl) {
+                LogMsg(OPENSEARCH_DEBUG, "Using cached result schema.");
+                schema = cached->second.schema;
+                return true;
+            }
+            m_describe_cache.erase(cached);
+        }
+    }
+
+    // Only the schema is needed, so ask for a single row and let go of the
+    // server cursor straight away
+    std::unique_ptr< OpenSearchResult > probe =
+        ExecuteQuery(statement, "1", stream);
+    if (!probe) {
+        return false;
+    }
+    if (!probe->cursor.empty()) {
+        SendCloseCursorRequest(probe->cursor, &stream);
+    }
+
+    schema.clear();
+    if (probe->streamed) {
+        schema = std::move(probe->schema);
+    } else {
+        rabbit::array schema_array = probe->opensearch_result_doc["schema"];
+        for (rabbit::array::iterator it = schema_array.begin();
+             it != schema_array.end(); ++it) {
+            schema.push_back(std::make_pair(it->at("name").as_string(),
+                                            it->at("type").as_string()));
+        }
+    }
+    if (m_metadata_cache_ttl.count() != 0) {
+        std::scoped_lock lock(m_describe_mutex);
+        if (m_describe_cache.size() >= DESCRIBE_CACHE_SIZE) {
+            m_describe_cache.clear();
+        }
+        m_describe_cache[statement] = DescribedSchema{schema, now};
+    }
+    return true;
+}
+
+bool OpenSearchCommunication::ProbeFlatSchema(
+    const std::string& statement,
+    std::vector< std::pair< std::string, std::string > >& schema,
+    OpenSearchResultStream& stream) {
+    if (!ProbeSchema(statement, schema, stream)) {
+        // The query itself reports what is wrong with it
+        stream.ClearError();
+        return false;
+    }
+    if (schema.empty()) {
+        return false;
+    }
+    for (auto& column : schema) {
+        if (!IsFlatFormatType(column.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool OpenSearchCommunication::CheckQuery(OpenSearchResultStream& stream,
+                                         const char* query) {
+    if (!query) {
+        SetQueryError(stream, "Execution error", "Query is NULL",
+                      ConnErrorType::CONN_ERROR_INVALID_NULL_PTR);
+        return false;
+    } else if (!m_http_client) {
+        SetQueryError(stream, "Execution error",
+                      "Unable to connect. Please try connecting again.",
+                      ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
+        return false;
+    }
+    return true;
+}
+
+void OpenSearchCommunication::SetQueryError(OpenSearchResultStream& stream,
+                                            const std::string& reason,
+                                            const std::string& message,
+                                            ConnErrorType error_type) {
+    stream.SetError(NewErrorDetails(reason, message, error_type));
+    LogMsg(OPENSEARCH_ERROR, message.c_str());
+}
+
+std::unique_ptr< OpenSearchResult > OpenSearchCommunication::ExecuteQuery(
+    const std::string& statement, const std::string& fetch_size,
+    OpenSearchResultStream& stream, bool flat) {
+    // The delimited formats carry no types, they are taken from a one row
+    // probe of the query in the JDBC format
+    std::vector< std::pair< std::string, std::string > > flat_schema;
+    flat = flat && ProbeFlatSchema(statement, flat_schema, stream);
+
     std::string msg = "Attempting to execute a query \"" + statement + "\"";
     LogMsg(OPENSEARCH_DEBUG, msg.c_str());
 
     // Issue request
-    std::shared_ptr< Aws::Http::HttpResponse > response =
-        IssueRequest(sql_endpoint, Aws::Http::HttpMethod::HTTP_POST,
-                     ctype, statement, fetch_size);
+    std::shared_ptr< Aws::Http::HttpResponse > response = IssueRequest(
+        flat ? sql_endpoint + m_flat_format_params : sql_endpoint,
+        Aws::Http::HttpMethod::HTTP_POST, ctype, statement, fetch_size, "",
+        &stream);
 
     // Validate response
     if (response == nullptr) {
-        m_error_message =
-            "Failed to receive response from query. "
-            "Received NULL response.";
-        SetErrorDetails("Execution error", m_error_message,
-                        ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        return -1;
+        SetQueryError(stream, "Execution error",
+                      "Failed to receive response from query. "
+                      "Received NULL response.",
+                      ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
+        return nullptr;
     }
 
     // Convert body from Aws IOStream to string
     std::unique_ptr< OpenSearchResult > result = std::make_unique< OpenSearchResult >();
     AwsHttpResponseToString(response, result->result_json);
+    stream.m_bytes_received += result->result_json.size();
+    stream.m_pages_fetched++;
 
     // If response was not valid, set error
     if (response->GetResponseCode() != Aws::Http::HttpResponseCode::OK) {
-        m_error_type = ConnErrorType::CONN_ERROR_QUERY_SYNTAX;
-        m_error_message =
+        std::string error_message =
             "Http response code was not OK. Code received: "
             + std::to_string(static_cast< long >(response->GetResponseCode()))
             + ".";
         if (response->HasClientError())
-            m_error_message +=
+            error_message +=
                 " Client error: '" + response->GetClientErrorMessage() + "'.";
+        std::shared_ptr< ErrorDetails > error_details;
         if (!result->result_json.empty()) {
-            m_error_details = ParseErrorResponse(*result.get());
-            m_error_message +=
+            error_details = ParseErrorResponse(*result.get());
+            error_message +=
                 " Response error: '" + result->result_json + "'.";
+        } else {
+            error_details =
+                NewErrorDetails("Execution error", error_message,
+                                ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
         }
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        return -1;
+        error_details->type = ConnErrorType::CONN_ERROR_QUERY_SYNTAX;
+        stream.SetError(error_details);
+        LogMsg(OPENSEARCH_ERROR, error_message.c_str());
+        return nullptr;
     }
 
-    // Add to result queue and return
     try {
-        ConstructOpenSearchResult(*result);
+        auto start = std::chrono::steady_clock::now();
+        if (flat) {
+            LogMsg(OPENSEARCH_DEBUG, "Parsing delimited result.");
+            result->schema = std::move(flat_schema);
+            ParseDelimitedResponse(*result, m_flat_separator);
+            std::vector< std::string > column_names;
+            for (auto& it : result->schema) {
+                column_names.push_back(it.first);
+            }
+            SetColumnInfo(*result, column_names);
+        } else {
+            ConstructOpenSearchResult(*result);
+        }
+        stream.m_parse_time_us +=
+            std::chrono::duration_cast< std::chrono::microseconds >(
+                std::chrono::steady_clock::now() - start)
+                .count();
     } catch (std::runtime_error& e) {
-        m_error_message =
+        if (flat) {
+            // Such as a line break in an unquoted value, the JDBC format has
+            // no such ambiguity
+            LogMsg(OPENSEARCH_WARNING,
+                   ("Using the JDBC format instead: " + std::string(e.what()))
+                       .c_str());
+            return ExecuteQuery(statement, fetch_size, stream, false);
+        }
+        std::string error_message =
             "Received runtime exception: " + std::string(e.what());
         if (!result->result_json.empty()) {
-            m_error_message += " Result body: " + result->result_json;
+            error_message += " Result body: " + result->result_json;
         }
-        SetErrorDetails("Execution error", m_error_message,
-                        ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        return -1;
+        SetQueryError(stream, "Execution error", error_message,
+                      ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
+        return nullptr;
     }
+    return result;
+}
 
-    const std::string cursor = result->cursor;
-    while (!m_result_queue.push(QUEUE_TIMEOUT, result.get())) {
-        if (ConnStatusType::CONNECTION_OK == m_status) {
-            return -1;
-        }
+int OpenSearchCommunication::StartRetrieval(
+    OpenSearchResultStream& stream, std::unique_ptr< OpenSearchResult > first,
+    const std::string& cursor,
+    std::shared_ptr< const OpenSearchResultCache::Pages > replay_pages) {
+    // PopResult takes the lock after a pop, so it only sees the state of
+    // this query once the first page is counted
+    std::scoped_lock lock(stream.m_retrieval_mutex);
+    stream.m_prefetch_metrics = prefetch_metrics();
+    // Pages of an earlier query on the stream were dropped by StopRetrieval
+    stream.m_result_queue->clear();
+    stream.m_result_queue->reset();
+    if (!stream.m_result_queue->try_push(first.get())) {
+        return -1;
+    }
+    first.release();
+
+    stream.m_conn = this;
+    stream.m_cursor = cursor;
+    stream.m_replay_pages = std::move(replay_pages);
+    stream.m_replay_next = 1;
+    stream.m_fetching = false;
+    stream.m_pages_ahead = 1;
+    stream.m_next_fetch = 0;
+    stream.m_next_publish = 0;
+    stream.m_failed_page = SIZE_MAX;
+    stream.m_decoded.clear();
+    stream.m_cursor_page_validated = false;
+    if (!HasMorePages(stream)) {
+        stream.m_result_queue->close();
+        StoreCachedResult(stream);
+        return 0;
     }
 
-    result.release();
+    // The next pages are retrieved asynchronously. Mark retrieval as started
+    // before the first fetch so PopResult waits for its page.
+    stream.m_is_retrieving = true;
+    ScheduleCursorFetch(stream);
+    return 0;
+}
 
-    if (!cursor.empty()) {
-        // If the response has a cursor, this thread will retrieve more result
-        // pages asynchronously.
-        std::thread([&, cursor]() { SendCursorQueries(cursor); }).detach();
+bool OpenSearchCommunication::HasMorePages(OpenSearchResultStream& stream) {
+    if (stream.m_replay_pages) {
+        return stream.m_replay_next < stream.m_replay_pages->size();
     }
+    return !stream.m_cursor.empty();
+}
 
-    return 0;
+void OpenSearchCommunication::ScheduleCursorFetch(
+    OpenSearchResultStream& stream) {
+    // Pages are not fetched further ahead of the statement than the prefetch
+    // depth, the pop that makes room schedules the next fetch
+    if (stream.m_fetching || !stream.m_is_retrieving
+        || stream.m_failed_page != SIZE_MAX
+        || stream.m_pages_ahead >= stream.m_prefetch_depth
+        || !HasMorePages(stream)) {
+        return;
+    }
+    stream.m_fetching = true;
+    stream.m_pages_ahead++;
+    stream.m_tasks++;
+    const size_t page = stream.m_next_fetch++;
+    // Tasks are queued per connection, so a connection paging through many
+    // results does not hold up the others
+    AWS_SDK_HELPER
+        .IoExecutor(m_io_threads, !m_io_threads_checked.exchange(true))
+        .submit([this, &stream, page]() { FetchCursorPage(stream, page); },
+                this);
 }
 
-void OpenSearchCommunication::SendCursorQueries(std::string cursor) {
-    if (cursor.empty()) {
+void OpenSearchCommunication::FetchCursorPage(OpenSearchResultStream& stream,
+                                              size_t page) {
+    std::string cursor;
+    std::shared_ptr< const OpenSearchResultCache::Pages > replay_pages;
+    size_t replay_index = 0;
+    {
+        std::scoped_lock lock(stream.m_retrieval_mutex);
+        cursor = stream.m_cursor;
+        replay_pages = stream.m_replay_pages;
+        replay_index = stream.m_replay_next;
+    }
+    // Retrieval may have been stopped while the task was queued
+    if (!stream.m_is_retrieving) {
+        EndCursorTask(stream);
         return;
     }
-    m_is_retrieving = true;
 
-    try {
-        while (!cursor.empty() && m_is_retrieving) {
+    std::unique_ptr< OpenSearchResult > result;
+    std::string next_cursor;
+    if (replay_pages) {
+        // Cached pages go through the queue like fetched ones, so the
+        // statement keeps its memory bounds
+        result = CopyCachedPage(*(*replay_pages)[replay_index]);
+    } else {
+        try {
             std::shared_ptr< Aws::Http::HttpResponse > response = IssueRequest(
-                sql_endpoint, Aws::Http::HttpMethod::HTTP_POST,
-                ctype, "", "", cursor);
-            if (response == nullptr) {
-                m_error_message =
-                    "Failed to receive response from cursor. "
-                    "Received NULL response.";
-                SetErrorDetails("Cursor error", m_error_message,
-                                ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
-                LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
+                sql_endpoint, Aws::Http::HttpMethod::HTTP_POST, ctype, "", "",
+                cursor, &stream);
+            // A response cut short by StopRetrieval is dropped, it closes the
+            // cursor the page was requested with
+            if (!stream.m_is_retrieving) {
+                EndCursorTask(stream);
                 return;
             }
-
-            std::unique_ptr< OpenSearchResult > result = std::make_unique< OpenSearchResult >();
-            AwsHttpResponseToString(response, result->result_json);
-            PrepareCursorResult(*result);
-
-            if (result->opensearch_result_doc.has("cursor")) {
-                cursor = result->opensearch_result_doc["cursor"].as_string();
-                result->cursor = result->opensearch_result_doc["cursor"].as_string();
+            if (response == nullptr) {
+                FailCursorPage(stream, page,
+                               "Failed to receive response from cursor. "
+                               "Received NULL response.");
             } else {
-                SendCloseCursorRequest(cursor);
-                cursor.clear();
+                result = std::make_unique< OpenSearchResult >();
+                AwsHttpResponseToString(response, result->result_json);
+                stream.m_bytes_received += result->result_json.size();
+                stream.m_pages_fetched++;
+
+                // Reading just enough of the response to request the next
+                // page, it is fetched while this one is decoded
+                next_cursor = ReadResponseCursor(result->result_json);
+                if (next_cursor.empty()) {
+                    SendCloseCursorRequest(cursor, &stream);
+                }
             }
+        } catch (std::runtime_error& e) {
+            result.reset();
+            FailCursorPage(stream, page,
+                           "Received runtime exception: "
+                               + std::string(e.what()));
+        }
+    }
 
-            while (m_is_retrieving
-                   && !m_result_queue.push(QUEUE_TIMEOUT, result.get())) {
-            }
+    {
+        std::scoped_lock lock(stream.m_retrieval_mutex);
+        stream.m_fetching = false;
+        if (result && replay_pages) {
+            stream.m_replay_next++;
+        } else if (result) {
+            stream.m_cursor = std::move(next_cursor);
+        }
+        ScheduleCursorFetch(stream);
+    }
 
-            // Don't release when attempting to push to the queue as it may take
-            // multiple tries.
-            result.release();
+    if (result && !replay_pages) {
+        try {
+            auto start = std::chrono::steady_clock::now();
+            DecodeCursorPage(stream, *result);
+            stream.m_parse_time_us +=
+                std::chrono::duration_cast< std::chrono::microseconds >(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+        } catch (std::runtime_error& e) {
+            result.reset();
+            FailCursorPage(stream, page,
+                           "Received runtime exception: "
+                               + std::string(e.what()));
+        }
+    }
+    PublishCursorPage(stream, page, std::move(result));
+    EndCursorTask(stream);
+}
+
+void OpenSearchCommunication::FailCursorPage(OpenSearchResultStream& stream,
+                                             size_t page,
+                                             const std::string& message) {
+    {
+        // Pages after the failed one are dropped, the ones before it are
+        // still published. Only the first failure is reported.
+        std::scoped_lock lock(stream.m_retrieval_mutex);
+        const bool first = (stream.m_failed_page == SIZE_MAX);
+        stream.m_failed_page = std::min(stream.m_failed_page, page);
+        if (!first) {
+            return;
+        }
+    }
+    // Reported by the statement reading the stream, the connection runs
+    // the queries of other statements meanwhile
+    stream.SetError(NewErrorDetails("Cursor error", message,
+                                    ConnErrorType::CONN_ERROR_QUERY_SYNTAX));
+    LogMsg(OPENSEARCH_ERROR, message.c_str());
+}
+
+void OpenSearchCommunication::PublishCursorPage(
+    OpenSearchResultStream& stream, size_t page,
+    std::unique_ptr< OpenSearchResult > result) {
+    std::scoped_lock lock(stream.m_retrieval_mutex);
+    if (result) {
+        stream.m_decoded.emplace(page, std::move(result));
+    }
+    // Pages decoded out of order wait for the ones fetched before them
+    auto it = stream.m_decoded.begin();
+    while (it != stream.m_decoded.end() && it->first == stream.m_next_publish
+           && it->first < stream.m_failed_page && stream.m_is_retrieving) {
+        RecordCachedPage(stream, *it->second);
+        // The queue has room for every page ahead of the statement, it owns
+        // the page once it is pushed
+        if (stream.m_result_queue->try_push(it->second.get())) {
+            it->second.release();
+        }
+        stream.m_next_publish++;
+        it = stream.m_decoded.erase(it);
+    }
+}
+
+void OpenSearchCommunication::EndCursorTask(OpenSearchResultStream& stream) {
+    std::string cursor;
+    bool last = false;
+    {
+        std::scoped_lock lock(stream.m_retrieval_mutex);
+        // The last task of a result that failed or has no pages left to
+        // fetch ends it. Nothing is scheduled after that.
+        last = stream.m_tasks == 1 && stream.m_is_retrieving
+               && (stream.m_failed_page != SIZE_MAX || !HasMorePages(stream));
+        if (last) {
+            cursor = std::move(stream.m_cursor);
+            stream.m_cursor.clear();
         }
-    } catch (std::runtime_error& e) {
-        m_error_message =
-            "Received runtime exception: " + std::string(e.what());
-        SetErrorDetails("Cursor error", m_error_message,
-                        ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
     }
 
-    if (!m_is_retrieving) {
-        m_result_queue.clear();
+    if (last) {
+        // An error ended the result before its last page, free the scroll
+        // context on the server instead of waiting for it to expire
+        if (!cursor.empty()) {
+            SendCloseCursorRequest(cursor, &stream);
+        }
+        std::scoped_lock lock(stream.m_retrieval_mutex);
+        if (stream.m_failed_page == SIZE_MAX && stream.m_is_retrieving) {
+            StoreCachedResult(stream);
+        } else {
+            stream.m_cache_pages.reset();
+        }
+        stream.m_decoded.clear();
+        // Wakes PopResult if it waits for a page that will not come
+        stream.m_is_retrieving = false;
+        stream.m_result_queue->close();
+    }
+
+    std::scoped_lock lock(stream.m_retrieval_mutex);
+    stream.m_tasks--;
+    stream.m_tasks_done.notify_all();
+}
+
+void OpenSearchCommunication::DecodeCursorPage(
+    OpenSearchResultStream& stream, OpenSearchResult& opensearch_result) {
+    if (m_rt_opts.conn.use_dom_parser) {
+        // Once a page of this query passed validation, the following pages
+        // may be trusted to have the same layout
+        const bool validate = !(m_rt_opts.conn.skip_cursor_validation
+                                && stream.m_cursor_page_validated);
+        PrepareCursorResult(opensearch_result, validate);
+        if (validate)
+            stream.m_cursor_page_validated = true;
+        if (opensearch_result.opensearch_result_doc.has("cursor"))
+            opensearch_result.cursor =
+                opensearch_result.opensearch_result_doc["cursor"].as_string();
     } else {
-        m_is_retrieving = false;
+        ParseCursorResponse(opensearch_result);
     }
 }
 
-void OpenSearchCommunication::SendCloseCursorRequest(const std::string& cursor) {
+void OpenSearchCommunication::SendCloseCursorRequest(
+    const std::string& cursor, OpenSearchResultStream* stream) {
     std::shared_ptr< Aws::Http::HttpResponse > response =
-        IssueRequest(sql_endpoint + "/close",
-                     Aws::Http::HttpMethod::HTTP_POST, ctype, "", "", cursor);
+        IssueRequest(sql_endpoint + "/close", Aws::Http::HttpMethod::HTTP_POST,
+                     ctype, "", "", cursor, stream);
+    // The rows of the result are complete either way, the scroll context
+    // then expires on the server
     if (response == nullptr) {
-        m_error_message =
-            "Failed to receive response from cursor close request. "
-            "Received NULL response.";
-        SetErrorDetails("Cursor error", m_error_message,
-                        ConnErrorType::CONN_ERROR_QUERY_SYNTAX);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
+        LogMsg(OPENSEARCH_ERROR,
+               "Failed to receive response from cursor close request. "
+               "Received NULL response.");
     }
 }
 
 void OpenSearchCommunication::StopResultRetrieval() {
-    m_is_retrieving = false;
-    m_result_queue.clear();
+    m_stream.StopRetrieval();
+}
+
+void OpenSearchCommunication::CancelRequests() {
+    ++m_request_generation;
+    m_stream.CancelRequests();
 }
 
 void OpenSearchCommunication::ConstructOpenSearchResult(OpenSearchResult& result) {
-    GetJsonSchema(result);
-    rabbit::array schema_array = result.opensearch_result_doc["schema"];
-    for (rabbit::array::iterator it = schema_array.begin();
-         it != schema_array.end(); ++it) {
-        std::string column_name = it->at("name").as_string();
+    std::vector< std::string > column_names;
+    if (m_rt_opts.conn.use_dom_parser) {
+        GetJsonSchema(result);
+        rabbit::array schema_array = result.opensearch_result_doc["schema"];
+        for (rabbit::array::iterator it = schema_array.begin();
+             it != schema_array.end(); ++it) {
+            column_names.push_back(it->at("name").as_string());
+        }
+        if (result.opensearch_result_doc.has("cursor")) {
+            result.cursor = result.opensearch_result_doc["cursor"].as_string();
+        }
+    } else {
+        LogMsg(OPENSEARCH_DEBUG, "Parsing result JSON with streaming parser.");
+        ParseQueryResponse(result);
+        for (auto& it : result.schema) {
+            column_names.push_back(it.first);
+        }
+    }
+    SetColumnInfo(result, column_names);
+}
 
+void OpenSearchCommunication::SetColumnInfo(
+    OpenSearchResult& result, const std::vector< std::string >& column_names) {
+    for (auto& column_name : column_names) {
         ColumnInfo col_info;
         col_info.field_name = column_name;
         col_info.type_oid = KEYWORD_TYPE_OID;
@@ -794,11 +1991,8 @@ void OpenSearchCommunication::ConstructOpenSearchResult(OpenSearchResult& result
 
         result.column_info.push_back(col_info);
     }
-    if (result.opensearch_result_doc.has("cursor")) {
-        result.cursor = result.opensearch_result_doc["cursor"].as_string();
-    }
     result.command_type = "SELECT";
-    result.num_fields = (uint16_t)schema_array.size();
+    result.num_fields = (uint16_t)column_names.size();
 }
 
 inline void OpenSearchCommunication::LogMsg(OpenSearchLogLevel level, const char* msg) {
@@ -815,11 +2009,97 @@ inline void OpenSearchCommunication::LogMsg(OpenSearchLogLevel level, const char
 }
 
 OpenSearchResult* OpenSearchCommunication::PopResult() {
-    OpenSearchResult* result = NULL;
-    while (!m_result_queue.pop(QUEUE_TIMEOUT, result) && m_is_retrieving) {
+    return m_stream.PopResult();
+}
+
+int OpenSearchCommunication::ReplayCachedResult(
+    OpenSearchResultStream& stream,
+    std::shared_ptr< const OpenSearchResultCache::Pages > pages) {
+    LogMsg(OPENSEARCH_DEBUG, "Using cached query result.");
+    return StartRetrieval(stream, CopyCachedPage(*pages->front()), "", pages);
+}
+
+void OpenSearchCommunication::RecordCachedPage(OpenSearchResultStream& stream,
+                                               const OpenSearchResult& page) {
+    if (!stream.m_cache_pages) {
+        return;
     }
+    stream.m_cache_bytes += CachedPageSize(page);
+    if (stream.m_cache_bytes > m_query_cache_budget) {
+        stream.m_cache_pages.reset();
+        return;
+    }
+    stream.m_cache_pages->push_back(CopyCachedPage(page));
+}
 
-    return result;
+void OpenSearchCommunication::StoreCachedResult(
+    OpenSearchResultStream& stream) {
+    if (!stream.m_cache_pages) {
+        return;
+    }
+    QueryResultCache().put(stream.m_cache_key, std::move(stream.m_cache_pages),
+                           stream.m_cache_bytes, m_query_cache_budget);
+    stream.m_cache_pages.reset();
+}
+
+query_cache_metrics OpenSearchCommunication::GetQueryCacheMetrics() {
+    return QueryResultCache().metrics();
+}
+
+OpenSearchCatalogCache& OpenSearchCommunication::CatalogCache() {
+    return m_rt_opts.conn.shared_metadata_cache ? SharedCatalogCache()
+                                                : m_catalog_cache;
+}
+
+std::shared_ptr< const catalog_rows > OpenSearchCommunication::GetCatalogRows(
+    const std::string& query) {
+    if (m_metadata_cache_ttl.count() == 0) {
+        return nullptr;
+    }
+    std::shared_ptr< const catalog_rows > rows = CatalogCache().get(
+        m_server_info_key + "|" + query, m_metadata_cache_ttl);
+    catalog_cache_metrics metrics = CatalogCache().metrics();
+    std::string msg = std::string("Metadata cache ")
+                      + (rows ? "hit" : "miss") + " for '" + query + "', "
+                      + std::to_string(metrics.hits) + " of "
+                      + std::to_string(metrics.hits + metrics.misses)
+                      + " lookups hit.";
+    LogMsg(OPENSEARCH_DEBUG, msg.c_str());
+    return rows;
+}
+
+void OpenSearchCommunication::SetCatalogRows(
+    const std::string& query, std::shared_ptr< const catalog_rows > rows) {
+    if (m_metadata_cache_ttl.count() == 0) {
+        return;
+    }
+    CatalogCache().put(m_server_info_key + "|" + query, std::move(rows));
+}
+
+void OpenSearchCommunication::ClearCatalogCache() {
+    // A shared cache may hold entries of other servers or credentials
+    CatalogCache().clear(m_server_info_key + "|");
+    {
+        std::scoped_lock lock(m_describe_mutex);
+        m_describe_cache.clear();
+    }
+    LogMsg(OPENSEARCH_DEBUG, "Metadata cache cleared.");
+}
+
+catalog_cache_metrics OpenSearchCommunication::GetCatalogCacheMetrics() {
+    return CatalogCache().metrics();
+}
+
+prefetch_metrics OpenSearchCommunication::GetPrefetchMetrics() {
+    return m_stream.GetPrefetchMetrics();
+}
+
+query_metrics OpenSearchCommunication::GetQueryMetrics() {
+    return m_stream.GetQueryMetrics();
+}
+
+size_t OpenSearchCommunication::GetPrefetchDepth() {
+    return m_prefetch_depth;
 }
 
 // TODO #36 - Send query to database to get encoding
@@ -840,34 +2120,48 @@ bool OpenSearchCommunication::SetClientEncoding(std::string& encoding) {
     return false;
 }
 
-std::string OpenSearchCommunication::GetServerVersion() {
+bool OpenSearchCommunication::FetchServerInfo() {
+    if (m_has_server_info) {
+        return true;
+    }
     if (!m_http_client) {
         InitializeConnection();
     }
 
-    // Issue request
+    // Version, distribution and cluster name all come from one request
     std::shared_ptr< Aws::Http::HttpResponse > response =
         IssueRequest("", Aws::Http::HttpMethod::HTTP_GET, "", "", "");
     if (response == nullptr) {
         m_error_message =
-            "Failed to receive response from server version query. "
+            "Failed to receive response from main endpoint query. "
             "Received NULL response.";
         SetErrorDetails("Connection error", m_error_message,
                         ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
         LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        return "";
+        return false;
     }
 
-    // Parse server version
     if (response->GetResponseCode() == Aws::Http::HttpResponseCode::OK) {
         try {
             AwsHttpResponseToString(response, m_response_str);
             rabbit::document doc;
             doc.parse(m_response_str);
-            if (doc.has("version") && doc["version"].has("number")) {
-                return doc["version"]["number"].as_string();
+            m_server_info = ServerInfo();
+            if (doc.has("version")) {
+                if (doc["version"].has("number")) {
+                    m_server_info.version =
+                        doc["version"]["number"].as_string();
+                }
+                if (doc["version"].has("distribution")) {
+                    m_server_info.distribution =
+                        doc["version"]["distribution"].as_string();
+                }
             }
-
+            if (doc.has("cluster_name")) {
+                m_server_info.cluster_name = doc["cluster_name"].as_string();
+            }
+            m_has_server_info = true;
+            return true;
         } catch (const rabbit::type_mismatch& e) {
             m_error_message = "Error parsing main endpoint response: "
                               + std::string(e.what());
@@ -893,122 +2187,38 @@ std::string OpenSearchCommunication::GetServerVersion() {
         }
     }
     LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-    return "";
+    return false;
 }
 
-std::string OpenSearchCommunication::GetServerDistribution() {
-    if (!m_http_client) {
-        InitializeConnection();
+bool OpenSearchCommunication::GetServerInfo(ServerInfo& server_info) {
+    if (!FetchServerInfo()) {
+        return false;
     }
+    server_info = m_server_info;
+    return true;
+}
 
-    std::shared_ptr< Aws::Http::HttpResponse > response =
-        IssueRequest("", Aws::Http::HttpMethod::HTTP_GET, "", "", "");
-    if (response == nullptr) {
-        m_error_message =
-            "Failed to receive response from server version query. "
-            "Received NULL response.";
-        SetErrorDetails("Connection error", m_error_message,
-                        ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        return "";
-    }
+std::string OpenSearchCommunication::GetServerVersion() {
+    return FetchServerInfo() ? m_server_info.version : "";
+}
 
-    // Parse server version distribution
-    if (response->GetResponseCode() == Aws::Http::HttpResponseCode::OK) {
-        try {
-            AwsHttpResponseToString(response, m_response_str);
-            rabbit::document doc;
-            doc.parse(m_response_str);
-            if (doc.has("version") && doc["version"].has("distribution")) {
-                return doc["version"]["distribution"].as_string();
-            }
-        } catch (const rabbit::type_mismatch& e) {
-            m_error_message = "Error parsing main endpoint response: "
-                              + std::string(e.what());
-            SetErrorDetails("Connection error", m_error_message,
-                            ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-            LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        } catch (const rabbit::parse_error& e) {
-            m_error_message = "Error parsing main endpoint response: "
-                              + std::string(e.what());
-            SetErrorDetails("Connection error", m_error_message,
-                            ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-            LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        } catch (const std::exception& e) {
-            m_error_message = "Error parsing main endpoint response: "
-                              + std::string(e.what());
-            SetErrorDetails("Connection error", m_error_message,
-                            ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-            LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        } catch (...) {
-            LogMsg(OPENSEARCH_ERROR,
-                   "Unknown exception thrown when parsing main endpoint "
-                   "response.");
-        }
-    }
-    LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-    return "";
+std::string OpenSearchCommunication::GetServerDistribution() {
+    return FetchServerInfo() ? m_server_info.distribution : "";
 }
 
 std::string OpenSearchCommunication::GetClusterName() {
-    if (!m_http_client) {
-        InitializeConnection();
-    }
-
-    // Issue request
-    std::shared_ptr< Aws::Http::HttpResponse > response =
-        IssueRequest("", Aws::Http::HttpMethod::HTTP_GET, "", "", "");
-    if (response == nullptr) {
-        m_error_message =
-            "Failed to receive response from cluster name query. "
-            "Received NULL response.";
-        SetErrorDetails("Connection error", m_error_message,
-                        ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-        LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        return "";
-    }
-
-    // Parse cluster name
-    if (response->GetResponseCode() == Aws::Http::HttpResponseCode::OK) {
-        try {
-            AwsHttpResponseToString(response, m_response_str);
-            rabbit::document doc;
-            doc.parse(m_response_str);
-            if (doc.has("cluster_name")) {
-                return doc["cluster_name"].as_string();
-            }
+    return FetchServerInfo() ? m_server_info.cluster_name : "";
+}
 
-        } catch (const rabbit::type_mismatch& e) {
-            m_error_message = "Error parsing main endpoint response: "
-                              + std::string(e.what());
-            SetErrorDetails("Connection error", m_error_message,
-                            ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-            LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        } catch (const rabbit::parse_error& e) {
-            m_error_message = "Error parsing main endpoint response: "
-                              + std::string(e.what());
-            SetErrorDetails("Connection error", m_error_message,
-                            ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-            LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        } catch (const std::exception& e) {
-            m_error_message = "Error parsing main endpoint response: "
-                              + std::string(e.what());
-            SetErrorDetails("Connection error", m_error_message,
-                            ConnErrorType::CONN_ERROR_COMM_LINK_FAILURE);
-            LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-        } catch (...) {
-            LogMsg(OPENSEARCH_ERROR,
-                   "Unknown exception thrown when parsing main endpoint "
-                   "response.");
-        }
-    }
-    LogMsg(OPENSEARCH_ERROR, m_error_message.c_str());
-    return "";
+connect_metrics OpenSearchCommunication::GetConnectMetrics() {
+    return m_connect_metrics;
 }
 
 void OpenSearchCommunication::SetSqlEndpoint() {
-    std::string distribution = GetServerDistribution();
-    if (distribution.compare("opensearch") == 0) {
+    if (!FetchServerInfo()) {
+        m_server_info = ServerInfo();
+    }
+    if (m_server_info.distribution.compare("opensearch") == 0) {
         sql_endpoint = "/_plugins/_sql";
     } else {
         sql_endpoint = "/_opendistro/_sql";
@@ -8,12 +8,17 @@
 #define OPENSEARCH_COMMUNICATION
 
 // clang-format off
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <future>
 #include <regex>
 #include "opensearch_types.h"
 #include "opensearch_result_queue.h"
+#include "opensearch_result_cache.h"
+#include "opensearch_catalog_cache.h"
 
 //Keep rabbit at top otherwise it gives build error because of some variable names like max, min
 #ifdef __APPLE__
@@ -26,14 +31,115 @@
 #endif // __APPLE__
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <aws/core/Aws.h>
 #include <aws/core/http/HttpRequest.h>
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/http/HttpClient.h>
+#include <aws/core/auth/AWSAuthSigner.h>
 #include <aws/core/client/ClientConfiguration.h>
 // clang-format on
 
+// Counters for the cursor prefetch pipeline, reset on each ExecDirect.
+// A stall is a PopResult call that found no decoded page ready.
+typedef struct prefetch_metrics {
+    size_t pages_popped = 0;
+    size_t pop_stalls = 0;
+    uint64_t stall_time_us = 0;
+} prefetch_metrics;
+
+// Timings of the last ConnectDBStart. requests counts the HTTP round trips
+// it made, a warm connect served from the connection pool makes none.
+typedef struct connect_metrics {
+    uint64_t connect_time_us = 0;
+    size_t requests = 0;
+} connect_metrics;
+
+// HTTP and decoding cost of the running query, reset on each ExecDirect.
+// Cursor pages are fetched and decoded on other threads than the statement.
+typedef struct query_metrics {
+    uint64_t http_time_us = 0;
+    uint64_t bytes_received = 0;
+    uint64_t parse_time_us = 0;
+    size_t pages_fetched = 0;
+    // Spent authenticating the requests, signing them for IAM
+    uint64_t sign_time_us = 0;
+} query_metrics;
+
+class OpenSearchCommunication;
+
+// Pages of one query on their way from the server to a statement. Every
+// statement reads from its own stream, so the statements of a connection can
+// page through their results at the same time. The following pages of a
+// cursor are fetched by tasks on the driver I/O threads, one page per task.
+// The connection running the query must outlive the retrieval, which
+// StopRetrieval ends.
+class OpenSearchResultStream {
+   public:
+    explicit OpenSearchResultStream(
+        size_t prefetch_depth = DEFAULT_PREFETCH_DEPTH);
+    ~OpenSearchResultStream();
+
+    OpenSearchResult* PopResult();
+    // Returns once the cursor of an unfinished result is closed
+    void StopRetrieval();
+    // Aborts the requests of this stream in flight, including one sent by
+    // ExecDirect on another thread
+    void CancelRequests();
+    prefetch_metrics GetPrefetchMetrics();
+    query_metrics GetQueryMetrics();
+    // Error of the last query run on the stream, including one of a cursor
+    // page that ended its retrieval early. Empty if there was none.
+    std::string GetErrorMessage();
+    ConnErrorType GetErrorType();
+
+   private:
+    friend class OpenSearchCommunication;
+    void SetPrefetchDepth(size_t prefetch_depth);
+    void ResetQueryMetrics();
+    void SetError(std::shared_ptr< ErrorDetails > details);
+    void ClearError();
+
+    size_t m_prefetch_depth;
+    std::unique_ptr< OpenSearchResultQueue > m_result_queue;
+    std::atomic< bool > m_is_retrieving;
+    std::atomic< bool > m_cursor_page_validated;
+    std::atomic< size_t > m_request_generation;
+    // Retrieval state, guarded by m_retrieval_mutex. A single fetch is in
+    // flight at a time, the next page is fetched while the previous one is
+    // decoded. Pages are numbered in fetch order and published in it.
+    std::mutex m_retrieval_mutex;
+    std::condition_variable m_tasks_done;
+    OpenSearchCommunication* m_conn;
+    std::string m_cursor;
+    std::shared_ptr< const OpenSearchResultCache::Pages > m_replay_pages;
+    size_t m_replay_next;
+    size_t m_tasks;
+    bool m_fetching;
+    // Pages fetched or being fetched that the statement did not pop yet
+    size_t m_pages_ahead;
+    size_t m_next_fetch;
+    size_t m_next_publish;
+    // Number of the first page that failed, SIZE_MAX if none did
+    size_t m_failed_page;
+    std::map< size_t, std::unique_ptr< OpenSearchResult > > m_decoded;
+    prefetch_metrics m_prefetch_metrics;
+    std::atomic< uint64_t > m_http_time_us;
+    std::atomic< uint64_t > m_bytes_received;
+    std::atomic< uint64_t > m_parse_time_us;
+    std::atomic< size_t > m_pages_fetched;
+    std::atomic< uint64_t > m_sign_time_us;
+    // Pages of the running query, while it may still be cached
+    std::string m_cache_key;
+    std::shared_ptr< OpenSearchResultCache::Pages > m_cache_pages;
+    size_t m_cache_bytes;
+    // Set by the thread running the query and the I/O threads fetching its
+    // pages, read by the statement
+    std::mutex m_error_mutex;
+    std::shared_ptr< ErrorDetails > m_error_details;
+};
+
 class OpenSearchCommunication {
    public:
     OpenSearchCommunication();
@@ -48,45 +154,123 @@ class OpenSearchCommunication {
     bool ConnectDBStart();
     ConnStatusType GetConnectionStatus();
     void DropDBConnection();
-    void LogMsg(OpenSearchLogLevel level, const char* msg);
+    static void LogMsg(OpenSearchLogLevel level, const char* msg);
+    // Runs the query, its pages are then popped from stream. The versions
+    // without a stream use the one of the connection. A query reports its
+    // errors on its stream, so the statements of a connection can run theirs
+    // at the same time.
+    int ExecDirect(OpenSearchResultStream& stream, const char* query,
+                   const char* fetch_size_);
     int ExecDirect(const char* query, const char* fetch_size_);
-    void SendCursorQueries(std::string cursor);
+    // The requests of a statement go through its stream, so cancelling the
+    // statement leaves the other statements of the connection alone
+    OpenSearchResult* DescribeQuery(OpenSearchResultStream& stream,
+                                    const char* query);
     OpenSearchResult* PopResult();
+    prefetch_metrics GetPrefetchMetrics();
+    query_metrics GetQueryMetrics();
+    size_t GetPrefetchDepth();
+    query_cache_metrics GetQueryCacheMetrics();
+    // Rows of a catalog query cached within the metadata cache TTL, NULL if
+    // there are none or the cache is disabled
+    std::shared_ptr< const catalog_rows > GetCatalogRows(
+        const std::string& query);
+    void SetCatalogRows(const std::string& query,
+                        std::shared_ptr< const catalog_rows > rows);
+    void ClearCatalogCache();
+    catalog_cache_metrics GetCatalogCacheMetrics();
     std::string GetClientEncoding();
     bool SetClientEncoding(std::string& encoding);
     static bool IsSQLPluginEnabled(std::shared_ptr< ErrorDetails > error_details);
     bool CheckSQLPluginAvailability();
+    bool GetServerInfo(ServerInfo& server_info);
     std::string GetServerVersion();
     std::string GetServerDistribution();
     std::string GetClusterName();
+    connect_metrics GetConnectMetrics();
+    // Requests of a query pass its stream, which can cancel them and counts
+    // their time
     std::shared_ptr< Aws::Http::HttpResponse > IssueRequest(
         const std::string& endpoint, const Aws::Http::HttpMethod request_type,
         const std::string& content_type, const std::string& query,
-        const std::string& fetch_size = "", const std::string& cursor = "");
+        const std::string& fetch_size = "", const std::string& cursor = "",
+        OpenSearchResultStream* stream = nullptr);
     void AwsHttpResponseToString(
         std::shared_ptr< Aws::Http::HttpResponse > response,
         std::string& output);
-    void SendCloseCursorRequest(const std::string& cursor);
+    void SendCloseCursorRequest(const std::string& cursor,
+                                OpenSearchResultStream* stream = nullptr);
     void StopResultRetrieval();
+    // Aborts the requests in flight that were made without a stream of
+    // their own, including one sent by ExecDirect on another thread. Requests
+    // issued afterwards are not affected.
+    void CancelRequests();
     std::vector< std::string > GetColumnsWithSelectQuery(
-        const std::string table_name);
+        OpenSearchResultStream& stream, const std::string table_name);
     void SetSqlEndpoint();
 
     // the endpoint is set according to distribution (ES/OpenSearch)
     std::string sql_endpoint;
 
    private:
+    friend class OpenSearchResultStream;
     void InitializeConnection();
+    void InitializeAuthentication();
+    bool FetchServerInfo();
     bool CheckConnectionOptions();
     bool EstablishConnection();
+    bool CheckQuery(OpenSearchResultStream& stream, const char* query);
+    void SetQueryError(OpenSearchResultStream& stream,
+                       const std::string& reason, const std::string& message,
+                       ConnErrorType error_type);
+    // A flat query asks for the result as delimited text when its columns
+    // allow it
+    std::unique_ptr< OpenSearchResult > ExecuteQuery(
+        const std::string& statement, const std::string& fetch_size,
+        OpenSearchResultStream& stream, bool flat = false);
+    bool ProbeSchema(
+        const std::string& statement,
+        std::vector< std::pair< std::string, std::string > >& schema,
+        OpenSearchResultStream& stream);
+    bool ProbeFlatSchema(
+        const std::string& statement,
+        std::vector< std::pair< std::string, std::string > >& schema,
+        OpenSearchResultStream& stream);
+    int StartRetrieval(
+        OpenSearchResultStream& stream,
+        std::unique_ptr< OpenSearchResult > first, const std::string& cursor,
+        std::shared_ptr< const OpenSearchResultCache::Pages > replay_pages);
+    void FetchCursorPage(OpenSearchResultStream& stream, size_t page);
+    void FailCursorPage(OpenSearchResultStream& stream, size_t page,
+                        const std::string& message);
+    void PublishCursorPage(OpenSearchResultStream& stream, size_t page,
+                           std::unique_ptr< OpenSearchResult > result);
+    void EndCursorTask(OpenSearchResultStream& stream);
+    // Both called with the retrieval mutex of the stream held
+    bool HasMorePages(OpenSearchResultStream& stream);
+    void ScheduleCursorFetch(OpenSearchResultStream& stream);
     void ConstructOpenSearchResult(OpenSearchResult& result);
+    void SetColumnInfo(OpenSearchResult& result,
+                       const std::vector< std::string >& column_names);
     void GetJsonSchema(OpenSearchResult& opensearch_result);
-    void PrepareCursorResult(OpenSearchResult& opensearch_result);
+    void PrepareCursorResult(OpenSearchResult& opensearch_result,
+                             bool validate);
+    void DecodeCursorPage(OpenSearchResultStream& stream,
+                          OpenSearchResult& opensearch_result);
     std::shared_ptr< ErrorDetails > ParseErrorResponse(
         OpenSearchResult& opensearch_result);
     void SetErrorDetails(std::string reason, std::string message,
                          ConnErrorType error_type);
     void SetErrorDetails(ErrorDetails details);
+    size_t ReadCountOption(const std::string& value, size_t default_value,
+                           size_t minimum, const std::string& name);
+    int ReplayCachedResult(
+        OpenSearchResultStream& stream,
+        std::shared_ptr< const OpenSearchResultCache::Pages > pages);
+    void RecordCachedPage(OpenSearchResultStream& stream,
+                          const OpenSearchResult& page);
+    void StoreCachedResult(OpenSearchResultStream& stream);
+    OpenSearchCatalogCache& CatalogCache();
 
     // TODO #35 - Go through and add error messages on exit conditions
     std::string m_error_message;
@@ -96,13 +280,42 @@ class OpenSearchCommunication {
     ConnErrorType m_error_type;
     std::shared_ptr< ErrorDetails > m_error_details;
     bool m_valid_connection_options;
-    bool m_is_retrieving;
-    OpenSearchResultQueue m_result_queue;
+    size_t m_prefetch_depth;
+    size_t m_io_threads;
+    // Set once the count was compared with the running I/O pool
+    std::atomic< bool > m_io_threads_checked;
+    // Separator of the delimited response format, '\0' for JDBC JSON
+    char m_flat_separator;
+    std::string m_flat_format_params;
+    std::chrono::seconds m_query_cache_ttl;
+    size_t m_query_cache_budget;
+    std::chrono::seconds m_metadata_cache_ttl;
+    OpenSearchCatalogCache m_catalog_cache;
+    // Used by the callers that do not pass a stream of their own
+    OpenSearchResultStream m_stream;
     runtime_options m_rt_opts;
+    // Authentication of the requests, built by ConnectionOptions. The signer
+    // keeps the credentials of the profile until they are due for a refresh.
+    std::string m_basic_authorization;
+    std::shared_ptr< Aws::Client::AWSAuthV4Signer > m_signer;
     std::string m_client_encoding;
     std::string m_response_str;
     std::shared_ptr< Aws::Http::HttpClient > m_http_client;
+    std::string m_client_key;
+    std::string m_server_info_key;
+    ServerInfo m_server_info;
+    bool m_has_server_info;
+    std::atomic< size_t > m_request_count;
+    std::atomic< size_t > m_request_generation;
+    connect_metrics m_connect_metrics;
     std::string m_error_message_to_user;
+    // Result schemas of probed statements, kept for the metadata cache TTL
+    struct DescribedSchema {
+        std::vector< std::pair< std::string, std::string > > schema;
+        std::chrono::steady_clock::time_point described;
+    };
+    std::mutex m_describe_mutex;
+    std::unordered_map< std::string, DescribedSchema > m_describe_cache;
 };
 
 #endif
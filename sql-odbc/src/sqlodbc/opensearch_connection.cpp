@@ -90,6 +90,18 @@ int LIBOPENSEARCH_connect(ConnectionClass *self) {
     rt_opts.conn.server.assign(self->connInfo.server);
     rt_opts.conn.port.assign(self->connInfo.port);
     rt_opts.conn.timeout.assign(self->connInfo.response_timeout);
+    rt_opts.conn.use_dom_parser = (self->connInfo.use_dom_parser == 1);
+    rt_opts.conn.prefetch_depth.assign(self->connInfo.prefetch_depth);
+    rt_opts.conn.skip_cursor_validation =
+        (self->connInfo.skip_cursor_validation == 1);
+    rt_opts.conn.query_cache_ttl.assign(self->connInfo.query_cache_ttl);
+    rt_opts.conn.query_cache_size.assign(self->connInfo.query_cache_size);
+    rt_opts.conn.metadata_cache_ttl.assign(self->connInfo.metadata_cache_ttl);
+    rt_opts.conn.shared_metadata_cache =
+        (self->connInfo.shared_metadata_cache == 1);
+    rt_opts.conn.io_threads.assign(self->connInfo.io_threads);
+    rt_opts.conn.response_format.assign(self->connInfo.response_format);
+    rt_opts.conn.compression = (self->connInfo.compression == 1);
 
     // Authentication
     rt_opts.auth.auth_type.assign(self->connInfo.authtype);
@@ -126,12 +138,11 @@ int LIBOPENSEARCH_connect(ConnectionClass *self) {
         return 0;
     }
 
-    // Set server version
-    std::string server_version = GetServerVersion(opensearchconn);
-    STRCPY_FIXED(self->opensearch_version, server_version.c_str());
-
-    std::string cluster_name = GetClusterName(opensearchconn);
-    STRCPY_FIXED(self->cluster_name, cluster_name.c_str());
+    // Set server version and cluster name, both read while connecting
+    ServerInfo server_info;
+    GetServerInfo(opensearchconn, server_info);
+    STRCPY_FIXED(self->opensearch_version, server_info.version.c_str());
+    STRCPY_FIXED(self->cluster_name, server_info.cluster_name.c_str());
 
     self->opensearchconn = (void *)opensearchconn;
     return 1;
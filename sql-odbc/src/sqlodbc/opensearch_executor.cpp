@@ -0,0 +1,67 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "opensearch_executor.h"
+
+#include <algorithm>
+
+OpenSearchExecutor::OpenSearchExecutor(size_t thread_count)
+    : m_stopped(false) {
+    for (size_t i = 0; i < std::max< size_t >(thread_count, 1); i++) {
+        m_threads.emplace_back([this]() { run(); });
+    }
+}
+
+OpenSearchExecutor::~OpenSearchExecutor() {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_stopped = true;
+    }
+    m_cond.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void OpenSearchExecutor::submit(std::function< void() > task,
+                                const void* owner) {
+    {
+        std::scoped_lock lock(m_mutex);
+        auto& tasks = m_tasks[owner];
+        if (tasks.empty()) {
+            m_owners.push_back(owner);
+        }
+        tasks.push(std::move(task));
+    }
+    m_cond.notify_one();
+}
+
+void OpenSearchExecutor::run() {
+    while (true) {
+        std::function< void() > task;
+        {
+            std::unique_lock< std::mutex > lock(m_mutex);
+            m_cond.wait(lock, [&]() { return m_stopped || !m_owners.empty(); });
+            // Tasks still queued at shutdown are run, their callers wait
+            // for them
+            if (m_owners.empty()) {
+                return;
+            }
+            const void* owner = m_owners.front();
+            m_owners.pop_front();
+            auto it = m_tasks.find(owner);
+            task = std::move(it->second.front());
+            it->second.pop();
+            // An owner with more work goes to the back of the line
+            if (it->second.empty()) {
+                m_tasks.erase(it);
+            } else {
+                m_owners.push_back(owner);
+            }
+        }
+        task();
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef OPENSEARCH_EXECUTOR
+#define OPENSEARCH_EXECUTOR
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Fixed set of driver owned threads running blocking work, such as
+// asynchronously executed statements. The tasks of one owner run in the
+// order they were submitted, the owners with queued tasks take turns.
+class OpenSearchExecutor {
+    public:
+        OpenSearchExecutor(size_t thread_count);
+        ~OpenSearchExecutor();
+
+        void submit(std::function< void() > task,
+                    const void* owner = nullptr);
+
+    private:
+        void run();
+
+        std::vector< std::thread > m_threads;
+        std::unordered_map< const void*, std::queue< std::function< void() > > >
+            m_tasks;
+        // Owners with queued tasks, the next task is taken from the first
+        std::deque< const void* > m_owners;
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        bool m_stopped;
+};
+
+// Executor shared by every connection of the driver, started on first use
+// and stopped with the last connection. Defined next to the AWS SDK setup in
+// opensearch_communication.cpp.
+OpenSearchExecutor& DriverExecutor();
+
+#endif
@@ -7,6 +7,7 @@
 #include "opensearch_helper.h"
 
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
@@ -54,16 +55,11 @@ ConnErrorType GetErrorType(void* opensearch_conn) {
                    : ConnErrorType::CONN_ERROR_SUCCESS;
 }
 
-std::string GetServerVersion(void* opensearch_conn) {
+bool GetServerInfo(void* opensearch_conn, ServerInfo& server_info) {
     return opensearch_conn
-               ? static_cast< OpenSearchCommunication* >(opensearch_conn)->GetServerVersion()
-               : "";
-}
-
-std::string GetClusterName(void* opensearch_conn) {
-    return opensearch_conn
-               ? static_cast< OpenSearchCommunication* >(opensearch_conn)->GetClusterName()
-                   : "";
+               ? static_cast< OpenSearchCommunication* >(opensearch_conn)->GetServerInfo(
+                   server_info)
+               : false;
 }
 
 void* InitializeOpenSearchConn() {
@@ -77,8 +73,25 @@ int OpenSearchExecDirect(void* opensearch_conn, const char* statement, const cha
                : -1;
 }
 
-void OpenSearchSendCursorQueries(void* opensearch_conn, const char* cursor) {
-    static_cast< OpenSearchCommunication* >(opensearch_conn)->SendCursorQueries(cursor);
+int OpenSearchExecDirectStream(void* opensearch_conn, void* opensearch_stream,
+                               const char* statement, const char* fetch_size) {
+    return (opensearch_conn && opensearch_stream && statement)
+               ? static_cast< OpenSearchCommunication* >(opensearch_conn)
+                     ->ExecDirect(*static_cast< OpenSearchResultStream* >(
+                                      opensearch_stream),
+                                  statement, fetch_size)
+               : -1;
+}
+
+OpenSearchResult* OpenSearchDescribe(void* opensearch_conn,
+                                     void* opensearch_stream,
+                                     const char* statement) {
+    return (opensearch_conn && opensearch_stream && statement)
+               ? static_cast< OpenSearchCommunication* >(opensearch_conn)
+                     ->DescribeQuery(*static_cast< OpenSearchResultStream* >(
+                                         opensearch_stream),
+                                     statement)
+               : NULL;
 }
 
 OpenSearchResult* OpenSearchGetResult(void* opensearch_conn) {
@@ -87,6 +100,27 @@ OpenSearchResult* OpenSearchGetResult(void* opensearch_conn) {
                    : NULL;
 }
 
+OpenSearchResult* OpenSearchGetStreamResult(void* opensearch_stream) {
+    return opensearch_stream
+               ? static_cast< OpenSearchResultStream* >(opensearch_stream)
+                     ->PopResult()
+               : NULL;
+}
+
+std::string OpenSearchGetStreamError(void* opensearch_stream) {
+    return opensearch_stream
+               ? static_cast< OpenSearchResultStream* >(opensearch_stream)
+                     ->GetErrorMessage()
+               : "";
+}
+
+ConnErrorType OpenSearchGetStreamErrorType(void* opensearch_stream) {
+    return opensearch_stream
+               ? static_cast< OpenSearchResultStream* >(opensearch_stream)
+                     ->GetErrorType()
+               : ConnErrorType::CONN_ERROR_SUCCESS;
+}
+
 std::string OpenSearchGetClientEncoding(void* opensearch_conn) {
     return opensearch_conn
                ? static_cast< OpenSearchCommunication* >(opensearch_conn)->GetClientEncoding()
@@ -108,14 +142,66 @@ void OpenSearchClearResult(OpenSearchResult* opensearch_result) {
     delete opensearch_result;
 }
 
-void OpenSearchStopRetrieval(void* opensearch_conn) {
-    static_cast< OpenSearchCommunication* >(opensearch_conn)->StopResultRetrieval();
+void* OpenSearchCreateStream(void) {
+    return new OpenSearchResultStream();
+}
+
+void OpenSearchDestroyStream(void* opensearch_stream) {
+    delete static_cast< OpenSearchResultStream* >(opensearch_stream);
+}
+
+void OpenSearchStopStream(void* opensearch_stream) {
+    static_cast< OpenSearchResultStream* >(opensearch_stream)->StopRetrieval();
+}
+
+void OpenSearchCancelStream(void* opensearch_stream) {
+    static_cast< OpenSearchResultStream* >(opensearch_stream)->CancelRequests();
 }
 
 std::vector< std::string > OpenSearchGetColumnsWithSelectQuery(
-    void* opensearch_conn, const std::string table_name) {
-    return static_cast< OpenSearchCommunication* >(opensearch_conn)->GetColumnsWithSelectQuery(
-        table_name);
+    void* opensearch_conn, void* opensearch_stream,
+    const std::string table_name) {
+    return static_cast< OpenSearchCommunication* >(opensearch_conn)
+        ->GetColumnsWithSelectQuery(
+            *static_cast< OpenSearchResultStream* >(opensearch_stream),
+            table_name);
+}
+
+std::shared_ptr< const catalog_rows > OpenSearchGetCatalogRows(
+    void* opensearch_conn, const std::string& query) {
+    return static_cast< OpenSearchCommunication* >(opensearch_conn)->GetCatalogRows(
+        query);
+}
+
+void OpenSearchSetCatalogRows(void* opensearch_conn, const std::string& query,
+                              std::shared_ptr< const catalog_rows > rows) {
+    static_cast< OpenSearchCommunication* >(opensearch_conn)->SetCatalogRows(
+        query, std::move(rows));
+}
+
+void OpenSearchClearCatalogCache(void* opensearch_conn) {
+    static_cast< OpenSearchCommunication* >(opensearch_conn)->ClearCatalogCache();
+}
+
+void OpenSearchGetQueryMetrics(void* opensearch_stream,
+                               OpenSearchStatementMetrics* metrics) {
+    OpenSearchResultStream* stream =
+        static_cast< OpenSearchResultStream* >(opensearch_stream);
+    query_metrics query = stream->GetQueryMetrics();
+    metrics->http_time_us = static_cast< SQLULEN >(query.http_time_us);
+    metrics->bytes_received = static_cast< SQLULEN >(query.bytes_received);
+    metrics->parse_time_us = static_cast< SQLULEN >(query.parse_time_us);
+    metrics->pages_fetched = static_cast< SQLULEN >(query.pages_fetched);
+    metrics->sign_time_us = static_cast< SQLULEN >(query.sign_time_us);
+    metrics->queue_wait_us =
+        static_cast< SQLULEN >(stream->GetPrefetchMetrics().stall_time_us);
+}
+
+SQLULEN OpenSearchClockMicros(void) {
+    return static_cast< SQLULEN >(
+        std::chrono::duration_cast< std::chrono::microseconds >(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
 }
 
 // This class provides a cross platform way of entering critical sections
@@ -10,19 +10,33 @@
 #include "opensearch_types.h"
 
 #ifdef __cplusplus
+#include "opensearch_catalog_cache.h"
+
 // C++ interface
 std::string OpenSearchGetClientEncoding(void* opensearch_conn);
 bool OpenSearchSetClientEncoding(void* opensearch_conn, std::string& encoding);
 OpenSearchResult* OpenSearchGetResult(void* opensearch_conn);
+OpenSearchResult* OpenSearchGetStreamResult(void* opensearch_stream);
+// Error of the last query on the stream, empty if it had none
+std::string OpenSearchGetStreamError(void* opensearch_stream);
+ConnErrorType OpenSearchGetStreamErrorType(void* opensearch_stream);
+// Describes the statement with requests made through its result stream
+OpenSearchResult* OpenSearchDescribe(void* opensearch_conn,
+                                     void* opensearch_stream,
+                                     const char* statement);
 void OpenSearchClearResult(OpenSearchResult* opensearch_result);
 void* OpenSearchConnectDBParams(runtime_options& rt_opts, int expand_dbname,
                         unsigned int option_count);
-std::string GetServerVersion(void* opensearch_conn);
-std::string GetClusterName(void* opensearch_conn);
+bool GetServerInfo(void* opensearch_conn, ServerInfo& server_info);
 std::string GetErrorMsg(void* opensearch_conn);
 ConnErrorType GetErrorType(void* opensearch_conn);
 std::vector< std::string > OpenSearchGetColumnsWithSelectQuery(
-    void* opensearch_conn, const std::string table_name);
+    void* opensearch_conn, void* opensearch_stream,
+    const std::string table_name);
+std::shared_ptr< const catalog_rows > OpenSearchGetCatalogRows(
+    void* opensearch_conn, const std::string& query);
+void OpenSearchSetCatalogRows(void* opensearch_conn, const std::string& query,
+                              std::shared_ptr< const catalog_rows > rows);
 
 // C Interface
 extern "C" {
@@ -33,9 +47,22 @@ void XPlatformLeaveCriticalSection(void* critical_section_helper);
 void XPlatformDeleteCriticalSection(void** critical_section_helper);
 ConnStatusType OpenSearchStatus(void* opensearch_conn);
 int OpenSearchExecDirect(void* opensearch_conn, const char* statement, const char* fetch_size);
-void OpenSearchSendCursorQueries(void* opensearch_conn, const char* cursor);
+// Runs the statement on the connection, its pages are read from the stream
+int OpenSearchExecDirectStream(void* opensearch_conn, void* opensearch_stream,
+                               const char* statement, const char* fetch_size);
 void OpenSearchDisconnect(void* opensearch_conn);
-void OpenSearchStopRetrieval(void* opensearch_conn);
+// Result stream of a statement. Its retrieval has to be stopped before the
+// connection that ran the query is disconnected.
+void* OpenSearchCreateStream(void);
+void OpenSearchDestroyStream(void* opensearch_stream);
+void OpenSearchStopStream(void* opensearch_stream);
+void OpenSearchCancelStream(void* opensearch_stream);
+void OpenSearchClearCatalogCache(void* opensearch_conn);
+// Copies the HTTP, decoding and queue counters of the last query
+void OpenSearchGetQueryMetrics(void* opensearch_stream,
+                               OpenSearchStatementMetrics* metrics);
+// Microseconds of a monotonic clock, only meaningful as a difference
+SQLULEN OpenSearchClockMicros(void);
 #ifdef __cplusplus
 }
 #endif
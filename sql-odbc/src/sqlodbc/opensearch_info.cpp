@@ -12,7 +12,9 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // TODO #324 (SQL Plugin)- Update if OpenSearch extends support for multiple
@@ -74,7 +76,7 @@ const std::unordered_map< int, std::vector< int > > sql_opensearch_type_map = {
       OPENSEARCH_TYPE_OBJECT}},
     {SQL_TYPE_TIMESTAMP, {OPENSEARCH_TYPE_DATETIME}}};
 
-const std::unordered_map< std::string, int > data_name_data_type_map = {
+const std::unordered_map< std::string_view, int > data_name_data_type_map = {
     {OPENSEARCH_TYPE_NAME_BOOLEAN, SQL_BIT},
     {OPENSEARCH_TYPE_NAME_BYTE, SQL_TINYINT},
     {OPENSEARCH_TYPE_NAME_SHORT, SQL_SMALLINT},
@@ -160,6 +162,37 @@ class BindTemplate {
                         .c_str());
         }
     }
+    // Value of the last fetched row, so the row can be replayed from the
+    // catalog cache without a fetch
+    catalog_cell SaveData() {
+        catalog_cell cell{true, ""};
+        SQLPOINTER data = GetData();
+        if (data == NULL)
+            return cell;
+        cell.is_null = false;
+        if (GetType() == SQL_C_CHAR)
+            cell.data.assign(static_cast< const char * >(data));
+        else
+            cell.data.assign(static_cast< const char * >(data),
+                             static_cast< size_t >(GetSize()));
+        return cell;
+    }
+    void RestoreData(const catalog_cell &cell) {
+        if (cell.is_null) {
+            m_len = SQL_NULL_DATA;
+            return;
+        }
+        m_len = static_cast< SQLLEN >(cell.data.size());
+        UpdateData(const_cast< char * >(cell.data.data()), cell.data.size());
+    }
+    // Character data of the last fetched row without a copy, it changes with
+    // the next fetch
+    std::string_view AsStringView() {
+        if (GetType() != SQL_C_CHAR)
+            throw std::runtime_error("Column does not hold character data.");
+        const char *data = static_cast< const char * >(GetData());
+        return (data == NULL) ? std::string_view() : std::string_view(data);
+    }
     BindTemplate(const BindTemplate &) = default;
     BindTemplate &operator=(const BindTemplate &) = default;
     virtual std::string AsString() = 0;
@@ -399,9 +432,10 @@ void GenerateTableQuery(std::string &tables_query, const UWORD flag,
                         const bool table_valid);
 void AssignTableBindTemplates(bind_vector &tabs);
 void SetupTableQResInfo(QResultClass *res, EnvironmentClass *env);
-void SetTableTuples(QResultClass *res, const TableResultSet res_type,
+bool SetTableTuples(QResultClass *res, const TableResultSet res_type,
                     const bind_vector &bind_tbl, std::string &table_type,
                     StatementClass *stmt, StatementClass *tbl_stmt,
+                    const catalog_rows *cached_rows, catalog_rows *fetched_rows,
                     std::vector< std::string > *list_of_columns = NULL);
 
 // Table specific function declarations
@@ -465,10 +499,34 @@ void SetupTableQResInfo(QResultClass *res, EnvironmentClass *env) {
                         INFO_VARCHAR_SIZE);
 }
 
-void SetTableTuples(QResultClass *res, const TableResultSet res_type,
+// Rows come from cached_rows if it is set, otherwise they are fetched from
+// tbl_stmt and appended to fetched_rows. Returns true if every row of the
+// catalog query was read.
+bool SetTableTuples(QResultClass *res, const TableResultSet res_type,
                     const bind_vector &bind_tbl, std::string &table_type,
                     StatementClass *stmt, StatementClass *tbl_stmt,
+                    const catalog_rows *cached_rows, catalog_rows *fetched_rows,
                     std::vector< std::string > *list_of_columns) {
+    size_t cached_row = 0;
+    auto FetchRow = [&]() -> RETCODE {
+        if (cached_rows != NULL) {
+            if (cached_row == cached_rows->size())
+                return SQL_NO_DATA_FOUND;
+            const auto &row = (*cached_rows)[cached_row++];
+            for (size_t i = 0; i < bind_tbl.size(); i++)
+                bind_tbl[i]->RestoreData(row[i]);
+            return SQL_SUCCESS;
+        }
+        RETCODE result = OPENSEARCHAPI_Fetch(tbl_stmt);
+        if (SQL_SUCCEEDED(result) && fetched_rows != NULL) {
+            std::vector< catalog_cell > row;
+            row.reserve(bind_tbl.size());
+            for (const auto &bind : bind_tbl)
+                row.push_back(bind->SaveData());
+            fetched_rows->push_back(std::move(row));
+        }
+        return result;
+    };
     auto CheckResult = [&](const auto &res) {
         if (res != SQL_NO_DATA_FOUND) {
             SC_full_error_copy(stmt, tbl_stmt, FALSE);
@@ -478,52 +536,61 @@ void SetTableTuples(QResultClass *res, const TableResultSet res_type,
                     .c_str());
         }
     };
+    // SQLColumns binds more columns than SQLTables
+    const bool column_result = (bind_tbl.size() > COLUMNS_SQL_DATA_TYPE);
     auto AssignData = [&](auto *res, const auto &binds) {
         TupleField *tuple = QR_AddNew(res);
         // Since we do not support catalogs, we will return an empty string for
         // catalog names. This is required for Excel for Mac, which uses this
         // information for its Data Preview window.
-        std::string catalog("");
-        bind_tbl[TABLES_CATALOG_NAME]->UpdateData((void *)catalog.c_str(), 0);
+        bind_tbl[TABLES_CATALOG_NAME]->UpdateData((void *)"", 0);
 
         // TODO #630 - Revisit logic of adding tuples for SQLTables & SQLColumns
+        if (!column_result) {
+            for (size_t i = 0; i < binds.size(); i++)
+                binds[i]->AssignData(&tuple[i]);
+            return;
+        }
+
+        // Add data type for data loading issue in Power BI Desktop
+        auto data_type_it = data_name_data_type_map.find(
+            bind_tbl[COLUMNS_TYPE_NAME]->AsStringView());
+        const short data_type = static_cast< short >(
+            (data_type_it == data_name_data_type_map.end())
+                ? DEFAULT_TYPE_INT
+                : data_type_it->second);
         for (size_t i = 0; i < binds.size(); i++) {
-            // Add tuples for SQLColumns
-            if (binds.size() > COLUMNS_SQL_DATA_TYPE) {
-                // Add data type for data loading issue in Power BI Desktop
-                auto data_type = data_name_data_type_map
-                        .find(bind_tbl[COLUMNS_TYPE_NAME]->AsString())->second;
-                if (i == COLUMNS_DATA_TYPE) {
-                    set_tuplefield_int2(&tuple[COLUMNS_DATA_TYPE],
-                                        static_cast< short >(data_type));
-                } else if (i == COLUMNS_SQL_DATA_TYPE) {
-                    set_tuplefield_int2(&tuple[COLUMNS_SQL_DATA_TYPE],
-                                        static_cast< short >(data_type));
-                } else {
-                    binds[i]->AssignData(&tuple[i]);
-                }
-            }
-            // Add tuples for SQLTables
-            else {
+            if ((i == COLUMNS_DATA_TYPE) || (i == COLUMNS_SQL_DATA_TYPE))
+                set_tuplefield_int2(&tuple[i], data_type);
+            else
                 binds[i]->AssignData(&tuple[i]);
-            }
         }
     };
+    // Replace BASE TABLE with TABLE for Excel & Power BI SQLTables call
+    auto RenameBaseTable = [&]() {
+        if (!column_result
+            && (bind_tbl[TABLES_TABLE_TYPE]->AsStringView() == "BASE TABLE"))
+            bind_tbl[TABLES_TABLE_TYPE]->UpdateData((void *)"TABLE", 5);
+    };
 
     // General case
     if (res_type == TableResultSet::All) {
+        // Hash the columns once, tables can have thousands of them. The views
+        // refer to list_of_columns, which outlives this call.
+        std::unordered_set< std::string_view > selected_columns;
+        if (list_of_columns != NULL) {
+            selected_columns.reserve(list_of_columns->size());
+            for (const auto &column : *list_of_columns)
+                selected_columns.insert(column);
+        }
+
         RETCODE result = SQL_NO_DATA_FOUND;
         int ordinal_position = 0;
-        while (SQL_SUCCEEDED(result = OPENSEARCHAPI_Fetch(tbl_stmt))) {
-            if (bind_tbl[TABLES_TABLE_TYPE]->AsString() == "BASE TABLE") {
-                std::string table("TABLE");
-                bind_tbl[TABLES_TABLE_TYPE]->UpdateData((void *)table.c_str(),
-                                                        table.length());
-            }
-            if (list_of_columns != NULL && !list_of_columns->empty()) {
-                if (std::find(list_of_columns->begin(), list_of_columns->end(),
-                              bind_tbl[COLUMNS_COLUMN_NAME]->AsString())
-                    != list_of_columns->end()) {
+        while (SQL_SUCCEEDED(result = FetchRow())) {
+            RenameBaseTable();
+            if (!selected_columns.empty()) {
+                if (selected_columns.count(
+                        bind_tbl[COLUMNS_COLUMN_NAME]->AsStringView())) {
                     ordinal_position++;
                     bind_tbl[COLUMNS_ORDINAL_POSITION]->UpdateData(
                         &ordinal_position, 0);
@@ -534,6 +601,7 @@ void SetTableTuples(QResultClass *res, const TableResultSet res_type,
             }
         }
         CheckResult(result);
+        return true;
     } else if (res_type == TableResultSet::TableLookUp) {
         // Get accepted table types
         std::vector< std::string > table_types;
@@ -541,31 +609,27 @@ void SetTableTuples(QResultClass *res, const TableResultSet res_type,
             std::remove(table_type.begin(), table_type.end(), '\''),
             table_type.end());
         split(table_type, ",", table_types);
+        const std::unordered_set< std::string_view > accepted_types(
+            table_types.begin(), table_types.end());
 
         // Loop through all data
         RETCODE result = SQL_NO_DATA_FOUND;
-        while (SQL_SUCCEEDED(result = OPENSEARCHAPI_Fetch(tbl_stmt))) {
-            // Replace BASE TABLE with TABLE for Excel & Power BI SQLTables call
-            if (bind_tbl[TABLES_TABLE_TYPE]->AsString() == "BASE TABLE") {
-                std::string table("TABLE");
-                bind_tbl[TABLES_TABLE_TYPE]->UpdateData((void *)table.c_str(),
-                                                        table.length());
-            }
-            if (std::find(table_types.begin(), table_types.end(),
-                          bind_tbl[TABLES_TABLE_TYPE]->AsString())
-                != table_types.end()) {
+        while (SQL_SUCCEEDED(result = FetchRow())) {
+            RenameBaseTable();
+            if (accepted_types.count(
+                    bind_tbl[TABLES_TABLE_TYPE]->AsStringView()))
                 AssignData(res, bind_tbl);
-            }
         }
 
         CheckResult(result);
-
+        return true;
     }
     // Special cases - only need single grab for this one
     else {
         RETCODE result;
-        if (!SQL_SUCCEEDED(result = OPENSEARCHAPI_Fetch(tbl_stmt))) {
-            SC_full_error_copy(stmt, tbl_stmt, FALSE);
+        if (!SQL_SUCCEEDED(result = FetchRow())) {
+            if (tbl_stmt != NULL)
+                SC_full_error_copy(stmt, tbl_stmt, FALSE);
             throw std::runtime_error(
                 std::string("Failed to fetch data after query. Error code :"
                             + std::to_string(result))
@@ -593,6 +657,7 @@ void SetTableTuples(QResultClass *res, const TableResultSet res_type,
             else
                 set_tuplefield_string(&tuple[i], NULL_STRING);
         }
+        return false;
     }
 }
 
@@ -602,6 +667,8 @@ void GenerateColumnQuery(std::string &query, const std::string &table_name,
                          const std::string &column_name, const bool table_valid,
                          const bool column_valid, const UWORD flag);
 void AssignColumnBindTemplates(bind_vector &cols);
+std::vector< std::string > GetTableColumns(StatementClass *stmt,
+                                           const std::string &table_name);
 
 // Column Specific function declarations
 void SetupColumnQResInfo(QResultClass *res, EnvironmentClass *unused) {
@@ -692,29 +759,62 @@ void AssignColumnBindTemplates(bind_vector &cols) {
     cols.push_back(_SQLCHAR_(true, 18));          // IS_NULLABLE			18
 }
 
+// The column names are cached with the catalog query results, as single
+// column rows under the text of the query that returns them
+std::vector< std::string > GetTableColumns(StatementClass *stmt,
+                                           const std::string &table_name) {
+    ConnectionClass *conn = SC_get_conn(stmt);
+    const std::string query = "SELECT * FROM " + table_name + " LIMIT 0";
+    std::vector< std::string > columns;
+    std::shared_ptr< const catalog_rows > cached_rows =
+        OpenSearchGetCatalogRows(conn->opensearchconn, query);
+    if (cached_rows) {
+        for (const auto &row : *cached_rows)
+            columns.push_back(row[0].data);
+        return columns;
+    }
+
+    columns = OpenSearchGetColumnsWithSelectQuery(
+        conn->opensearchconn, stmt->result_stream, table_name);
+    // A failed query returns no columns as well, so that is not cached
+    if (!columns.empty()) {
+        auto rows = std::make_shared< catalog_rows >();
+        for (const auto &column : columns)
+            rows->push_back({{false, column}});
+        OpenSearchSetCatalogRows(conn->opensearchconn, query, rows);
+    }
+    return columns;
+}
+
 void GetCatalogData(const std::string &query, StatementClass *stmt,
                     StatementClass *sub_stmt, const TableResultSet res_type,
                     std::string &table_type,
                     void (*populate_binds)(bind_vector &),
                     void (*setup_qres_info)(QResultClass *, EnvironmentClass *),
                     std::vector< std::string > *list_of_columns) {
-    // Execute query
-    ExecuteQuery(SC_get_conn(stmt), reinterpret_cast< HSTMT * >(&sub_stmt),
-                 query);
+    ConnectionClass *conn = SC_get_conn(stmt);
+    std::shared_ptr< const catalog_rows > cached_rows =
+        OpenSearchGetCatalogRows(conn->opensearchconn, query);
 
-    // Bind Columns
+    // Execute query and bind columns, unless its rows are cached
     bind_vector binds;
     (*populate_binds)(binds);
-    std::for_each(binds.begin(), binds.end(),
-                  [&](const auto &b) { b->BindColumn(sub_stmt); });
+    if (!cached_rows) {
+        ExecuteQuery(conn, reinterpret_cast< HSTMT * >(&sub_stmt), query);
+        std::for_each(binds.begin(), binds.end(),
+                      [&](const auto &b) { b->BindColumn(sub_stmt); });
+    }
     QResultClass *res =
         SetupQResult(binds, stmt, sub_stmt, static_cast< int >(binds.size()));
 
     // Setup QResultClass
-    (*setup_qres_info)(
-        res, static_cast< EnvironmentClass * >(CC_get_env(SC_get_conn(stmt))));
-    SetTableTuples(res, res_type, binds, table_type, stmt, sub_stmt,
-                   list_of_columns);
+    (*setup_qres_info)(res,
+                       static_cast< EnvironmentClass * >(CC_get_env(conn)));
+    auto fetched_rows = std::make_shared< catalog_rows >();
+    if (SetTableTuples(res, res_type, binds, table_type, stmt, sub_stmt,
+                       cached_rows.get(), fetched_rows.get(), list_of_columns)
+        && !cached_rows)
+        OpenSearchSetCatalogRows(conn->opensearchconn, query, fetched_rows);
     CleanUp(stmt, sub_stmt, SQL_SUCCESS);
 }
 
@@ -844,9 +944,7 @@ OPENSEARCHAPI_Columns(HSTMT hstmt, const SQLCHAR *catalog_name_sql,
         // with DESCRIBE & SELECT * query
         std::vector< std::string > list_of_columns;
         if (table_valid) {
-            ConnectionClass *conn = SC_get_conn(stmt);
-            list_of_columns =
-                OpenSearchGetColumnsWithSelectQuery(conn->opensearchconn, table_name);
+            list_of_columns = GetTableColumns(stmt, table_name);
         }
 
         // TODO #324 (SQL Plugin)- evaluate catalog & schema support
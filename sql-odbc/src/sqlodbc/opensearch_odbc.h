@@ -539,6 +539,7 @@ typedef struct StatementOptions_ {
     void *bookmark_ptr;
     SQLUINTEGER metadata_id;
     SQLULEN stmt_timeout;
+    SQLULEN async_enable;
 } StatementOptions;
 
 /*	Used to pass extra query info to send_query */
@@ -612,6 +613,17 @@ typedef struct {
     char port[SMALL_REGISTRY_LEN];
     char response_timeout[SMALL_REGISTRY_LEN];
     char fetch_size[SMALL_REGISTRY_LEN];
+    char use_dom_parser;
+    char prefetch_depth[SMALL_REGISTRY_LEN];
+    char skip_cursor_validation;
+    char streaming_cursor;
+    char query_cache_ttl[SMALL_REGISTRY_LEN];
+    char query_cache_size[SMALL_REGISTRY_LEN];
+    char metadata_cache_ttl[SMALL_REGISTRY_LEN];
+    char shared_metadata_cache;
+    char io_threads[SMALL_REGISTRY_LEN];
+    char response_format[SMALL_REGISTRY_LEN];
+    char compression;
 
     // Authentication
     char authtype[MEDIUM_REGISTRY_LEN];
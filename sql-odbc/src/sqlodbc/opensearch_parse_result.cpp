@@ -33,14 +33,23 @@ bool _CC_Metadata_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *co
 bool _CC_No_Metadata_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *conn,
                                    const char *cursor,
                                            OpenSearchResult &opensearch_result);
-void GetSchemaInfo(schema_type &schema, json_doc &opensearch_result_doc);
+void GetSchemaInfo(schema_type &schema, OpenSearchResult &opensearch_result);
 bool AssignColumnHeaders(const schema_type &doc_schema, QResultClass *q_res,
                          const OpenSearchResult &opensearch_result);
+bool AssignTableData(OpenSearchResult &opensearch_result, QResultClass *q_res,
+                     size_t doc_schema_size, ColumnInfoClass &fields);
 bool AssignTableData(json_doc &opensearch_result_doc, QResultClass *q_res,
                      size_t doc_schema_size, ColumnInfoClass &fields);
 bool AssignRowData(const json_arr_it &row, size_t row_schema_size,
                    QResultClass *q_res, ColumnInfoClass &fields,
                    const size_t &row_size);
+bool AssignStreamedRowData(const OpenSearchResult &opensearch_result,
+                           size_t row, size_t row_schema_size,
+                           QResultClass *q_res, ColumnInfoClass &fields);
+bool AssignKeysetData(KeySet *ks, const std::string &ctid,
+                      const std::string &oid, QResultClass *q_res);
+void AssignNativeValue(TupleField &tuple, const DataCell &cell, OID type);
+void CommitRowData(QResultClass *q_res);
 void UpdateResultFields(QResultClass *q_res, const ConnectionClass *conn,
                         const SQLULEN starting_cached_rows, const char *cursor,
                         std::string &command_type);
@@ -129,10 +138,10 @@ BOOL CC_No_Metadata_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *
                : FALSE;
 }
 
-BOOL CC_Append_Table_Data(json_doc &opensearch_result_doc, QResultClass *q_res,
+BOOL CC_Append_Table_Data(OpenSearchResult &opensearch_result, QResultClass *q_res,
                           size_t doc_schema_size, ColumnInfoClass &fields) {
     ClearError();
-    return AssignTableData(opensearch_result_doc, q_res, doc_schema_size, fields)
+    return AssignTableData(opensearch_result, q_res, doc_schema_size, fields)
                ? TRUE
                : FALSE;
 }
@@ -146,12 +155,12 @@ bool _CC_No_Metadata_from_OpenSearchResult(QResultClass *q_res, ConnectionClass
 
     try {
         schema_type doc_schema;
-        GetSchemaInfo(doc_schema, opensearch_result.opensearch_result_doc);
+        GetSchemaInfo(doc_schema, opensearch_result);
 
         SQLULEN starting_cached_rows = q_res->num_cached_rows;
 
         // Assign table data and column headers
-        if (!AssignTableData(opensearch_result.opensearch_result_doc, q_res, doc_schema.size(),
+        if (!AssignTableData(opensearch_result, q_res, doc_schema.size(),
                              *(q_res->fields)))
             return false;
 
@@ -185,7 +194,7 @@ bool _CC_Metadata_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *co
     QR_set_conn(q_res, conn);
     try {
         schema_type doc_schema;
-        GetSchemaInfo(doc_schema, opensearch_result.opensearch_result_doc);
+        GetSchemaInfo(doc_schema, opensearch_result);
 
         // Assign table data and column headers
         if (!AssignColumnHeaders(doc_schema, q_res, opensearch_result))
@@ -223,12 +232,12 @@ bool _CC_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *conn,
     QR_set_conn(q_res, conn);
     try {
         schema_type doc_schema;
-        GetSchemaInfo(doc_schema, opensearch_result.opensearch_result_doc);
+        GetSchemaInfo(doc_schema, opensearch_result);
         SQLULEN starting_cached_rows = q_res->num_cached_rows;
 
         // Assign table data and column headers
         if ((!AssignColumnHeaders(doc_schema, q_res, opensearch_result))
-            || (!AssignTableData(opensearch_result.opensearch_result_doc, q_res, doc_schema.size(),
+            || (!AssignTableData(opensearch_result, q_res, doc_schema.size(),
                                  *(q_res->fields))))
             return false;
 
@@ -252,15 +261,23 @@ bool _CC_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *conn,
     return false;
 }
 
-void GetSchemaInfo(schema_type &schema, json_doc &opensearch_result_doc) {
-    json_arr schema_arr = opensearch_result_doc[JSON_KW_SCHEMA];
+void GetSchemaInfo(schema_type &schema, OpenSearchResult &opensearch_result) {
+    auto to_oid = [](const std::string &type_name) -> OID {
+        auto mapped_oid = type_to_oid_map.find(type_name);
+        return (mapped_oid == type_to_oid_map.end()) ? SQL_WVARCHAR
+                                                     : mapped_oid->second;
+    };
+
+    if (opensearch_result.streamed) {
+        for (auto &it : opensearch_result.schema)
+            schema.push_back(std::make_pair(it.first, to_oid(it.second)));
+        return;
+    }
+
+    json_arr schema_arr = opensearch_result.opensearch_result_doc[JSON_KW_SCHEMA];
     for (auto it : schema_arr) {
-        auto mapped_oid = type_to_oid_map.find(it[JSON_KW_TYPE].as_string());
-        OID type_oid = (mapped_oid == type_to_oid_map.end())
-                           ? SQL_WVARCHAR
-                           : mapped_oid->second;
-        schema.push_back(
-            std::make_pair(it[JSON_KW_NAME].as_string(), type_oid));
+        schema.push_back(std::make_pair(it[JSON_KW_NAME].as_string(),
+                                        to_oid(it[JSON_KW_TYPE].as_string())));
     }
 }
 
@@ -296,6 +313,38 @@ bool AssignColumnHeaders(const schema_type &doc_schema, QResultClass *q_res,
 
 // Responsible for looping through rows, allocating tuples and passing rows for
 // assignment
+bool AssignTableData(OpenSearchResult &opensearch_result, QResultClass *q_res,
+                     size_t doc_schema_size, ColumnInfoClass &fields) {
+    if (!opensearch_result.streamed)
+        return AssignTableData(opensearch_result.opensearch_result_doc, q_res,
+                               doc_schema_size, fields);
+
+    if (opensearch_result.num_rows == 0)
+        return true;
+    if (opensearch_result.row_width < doc_schema_size)
+        return false;
+
+    // The whole page fits in one arena block, text_size counts every value
+    // with its terminator
+    if (!TA_reserve(&q_res->arena, opensearch_result.text_size)) {
+        QR_set_rstatus(q_res, PORES_NO_MEMORY_ERROR);
+        QR_set_messageref(q_res, "Out of memory in allocating item buffer.");
+        return false;
+    }
+    for (size_t row = 0; row < opensearch_result.num_rows; row++) {
+        // Setup memory to receive tuple
+        if (!QR_prepare_for_tupledata(q_res))
+            return false;
+
+        // Assign row data
+        if (!AssignStreamedRowData(opensearch_result, row, doc_schema_size,
+                                   q_res, fields))
+            return false;
+    }
+
+    return true;
+}
+
 bool AssignTableData(json_doc &opensearch_result_doc, QResultClass *q_res,
                      size_t doc_schema_size, ColumnInfoClass &fields) {
     // Assign row info
@@ -344,14 +393,34 @@ bool AssignRowData(const json_arr_it &row, size_t row_schema_size,
         if (row_column->is_null()) {
             tuple[i].len = SQL_NULL_DATA;
             tuple[i].value = NULL;
+            tuple[i].arena = FALSE;
+            tuple[i].native = TUPLE_NATIVE_NONE;
         } else {
             // Copy string over to tuple
             const std::string data = row_column->str();
+            char *value;
             tuple[i].len = static_cast< int >(data.length());
-            QR_MALLOC_return_with_error(
-                tuple[i].value, char, data.length() + 1, q_res,
+            QR_ARENA_ALLOC_return_with_error(
+                value, data.length() + 1, q_res,
                 "Out of memory in allocating item buffer.", false);
-            strcpy((char *)tuple[i].value, data.c_str());
+            memcpy(value, data.c_str(), data.length() + 1);
+            tuple[i].value = value;
+            tuple[i].arena = TRUE;
+
+            // The document already holds numbers and booleans natively
+            DataCell cell;
+            cell.type = CellType::TEXT;
+            if (row_column->is_bool()) {
+                cell.type = CellType::BOOL;
+                cell.integer = row_column->as_bool() ? 1 : 0;
+            } else if (row_column->is_int64()) {
+                cell.type = CellType::INTEGER;
+                cell.integer = row_column->as_int64();
+            } else if (row_column->is_number()) {
+                cell.type = CellType::DOUBLE;
+                cell.number = row_column->as_double();
+            }
+            AssignNativeValue(tuple[i], cell, fields.coli_array[i].adtid);
 
             // If data length exceeds current display size, set display size
             if (fields.coli_array[i].display_size < tuple[i].len)
@@ -369,18 +438,131 @@ bool AssignRowData(const json_arr_it &row, size_t row_schema_size,
         }
 
         auto row_column = row.value_begin() + row_schema_size;
-        if (sscanf(row_column->str().c_str(), "(%u,%hu)", &ks->blocknum,
-                   &ks->offset)
-            != 2) {
+        if (!AssignKeysetData(ks, row_column->str(), (row_column + 1)->str(),
+                              q_res))
+            return false;
+    }
+
+    CommitRowData(q_res);
+    return true;
+}
+
+// Streamed counterpart of AssignRowData, cells come from the flat cell buffer
+// filled by the response parser
+bool AssignStreamedRowData(const OpenSearchResult &opensearch_result,
+                           size_t row, size_t row_schema_size,
+                           QResultClass *q_res, ColumnInfoClass &fields) {
+    const size_t row_size = opensearch_result.row_width;
+    const DataCell *cells = opensearch_result.datarows.data() + row * row_size;
+    TupleField *tuple =
+        q_res->backend_tuples + (q_res->num_cached_rows * row_size);
+
+    // Setup keyset if present
+    KeySet *ks = NULL;
+    if (QR_haskeyset(q_res)) {
+        ks = q_res->keyset + q_res->num_cached_keys;
+        ks->status = 0;
+    }
+
+    for (size_t i = 0; i < row_schema_size; i++) {
+        if (cells[i].length < 0) {
+            tuple[i].len = SQL_NULL_DATA;
+            tuple[i].value = NULL;
+            tuple[i].arena = FALSE;
+            tuple[i].native = TUPLE_NATIVE_NONE;
+        } else {
+            // Copy string over to tuple and terminate it
+            char *value;
+            tuple[i].len = static_cast< int >(cells[i].length);
+            QR_ARENA_ALLOC_return_with_error(
+                value, cells[i].length + 1, q_res,
+                "Out of memory in allocating item buffer.", false);
+            memcpy(value, opensearch_result.CellText(cells[i]),
+                   cells[i].length);
+            value[cells[i].length] = '\0';
+            tuple[i].value = value;
+            tuple[i].arena = TRUE;
+            AssignNativeValue(tuple[i], cells[i], fields.coli_array[i].adtid);
+
+            // If data length exceeds current display size, set display size
+            if (fields.coli_array[i].display_size < tuple[i].len)
+                fields.coli_array[i].display_size = tuple[i].len;
+        }
+    }
+
+    // If there are more rows than schema suggests, we have Keyset data
+    if (row_size > row_schema_size) {
+        if (ks == NULL) {
             QR_set_rstatus(q_res, PORES_INTERNAL_ERROR);
-            QR_set_message(q_res, "Failed to assign Keyset.");
+            QR_set_message(q_res,
+                           "Keyset was NULL, but Keyset data was expected.");
             return false;
         }
-        row_column++;
-        ks->oid = std::stoul(row_column->str(), nullptr, 10);
+
+        const DataCell &ctid = cells[row_schema_size];
+        const DataCell &oid = cells[row_schema_size + 1];
+        if (!AssignKeysetData(
+                ks,
+                std::string(opensearch_result.CellText(ctid),
+                            std::max(ctid.length, 0)),
+                std::string(opensearch_result.CellText(oid),
+                            std::max(oid.length, 0)),
+                q_res))
+            return false;
+    }
+
+    CommitRowData(q_res);
+    return true;
+}
+
+bool AssignKeysetData(KeySet *ks, const std::string &ctid,
+                      const std::string &oid, QResultClass *q_res) {
+    if (sscanf(ctid.c_str(), "(%u,%hu)", &ks->blocknum, &ks->offset) != 2) {
+        QR_set_rstatus(q_res, PORES_INTERNAL_ERROR);
+        QR_set_message(q_res, "Failed to assign Keyset.");
+        return false;
+    }
+    ks->oid = std::stoul(oid, nullptr, 10);
+    return true;
+}
+
+// Keeps the decoded value of a cell when it fits the column type, so that
+// numeric binds can skip parsing the text again
+void AssignNativeValue(TupleField &tuple, const DataCell &cell, OID type) {
+    tuple.native = TUPLE_NATIVE_NONE;
+    switch (type) {
+        case OPENSEARCH_TYPE_INT2:
+        case OPENSEARCH_TYPE_INT4:
+        case OPENSEARCH_TYPE_INT8:
+            if (cell.type == CellType::INTEGER) {
+                tuple.native = TUPLE_NATIVE_INT8;
+                tuple.native_value.int8 = cell.integer;
+            }
+            break;
+        case OPENSEARCH_TYPE_FLOAT4:
+        case OPENSEARCH_TYPE_FLOAT8:
+        case OPENSEARCH_TYPE_NUMERIC:
+            if (cell.type == CellType::INTEGER) {
+                tuple.native = TUPLE_NATIVE_INT8;
+                tuple.native_value.int8 = cell.integer;
+            } else if (cell.type == CellType::DOUBLE) {
+                tuple.native = TUPLE_NATIVE_FLOAT8;
+                tuple.native_value.float8 = cell.number;
+            }
+            break;
+        case OPENSEARCH_TYPE_BOOL:
+            if (cell.type == CellType::BOOL) {
+                tuple.native = TUPLE_NATIVE_BOOL;
+                tuple.native_value.int8 = cell.integer;
+            }
+            break;
+        default:
+            break;
     }
+}
 
-    // Increment relevant data
+// Increment relevant data once a row has been written
+void CommitRowData(QResultClass *q_res) {
     q_res->cursTuple++;
     if (q_res->num_fields > 0)
         QR_inc_num_cache(q_res);
@@ -389,7 +571,6 @@ bool AssignRowData(const json_arr_it &row, size_t row_schema_size,
 
     if ((SQLULEN)q_res->cursTuple >= q_res->num_total_read)
         q_res->num_total_read = q_res->cursTuple + 1;
-    return true;
 }
 
 void UpdateResultFields(QResultClass *q_res, const ConnectionClass *conn,
@@ -432,9 +613,10 @@ bool QR_prepare_for_tupledata(QResultClass *q_res) {
         return true;
     }
 
-    // If total tuples > allocated tuples, need to reallocate
+    // If cached tuples > allocated tuples, need to reallocate. Rows discarded
+    // by a streaming cursor no longer take room in the cache
     if (q_res->num_fields > 0
-        && QR_get_num_total_tuples(q_res) >= q_res->count_backend_allocated) {
+        && q_res->num_cached_rows >= q_res->count_backend_allocated) {
         SQLLEN tuple_size = (q_res->count_backend_allocated < 1)
                                 ? TUPLE_MALLOC_INC
                                 : q_res->count_backend_allocated * 2;
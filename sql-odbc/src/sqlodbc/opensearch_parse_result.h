@@ -31,7 +31,7 @@ BOOL CC_Metadata_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *con
 BOOL CC_No_Metadata_from_OpenSearchResult(QResultClass *q_res, ConnectionClass *conn,
                                   const char *cursor,
                                           OpenSearchResult &opensearch_result);
-BOOL CC_Append_Table_Data(json_doc &opensearch_result_doc, QResultClass *q_res,
+BOOL CC_Append_Table_Data(OpenSearchResult &opensearch_result, QResultClass *q_res,
                           size_t doc_schema_size, ColumnInfoClass &fields);
 #endif
 #endif
@@ -0,0 +1,788 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "opensearch_response_parser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+// clang-format off
+#include <rapidjson/reader.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/error/en.h>
+// clang-format on
+
+// Numbers are kept as the text the server sent, so no precision is lost
+// before the value reaches copy_and_convert_field. Datarows cells are decoded
+// once more into a native value next to that text.
+static const unsigned PARSE_FLAGS = rapidjson::kParseNumbersAsStringsFlag;
+static const unsigned NUMBER_PARSE_FLAGS = rapidjson::kParseFullPrecisionFlag;
+
+namespace {
+enum class ResponseMember {
+    NONE = 0,
+    SCHEMA,
+    CURSOR,
+    TOTAL,
+    DATAROWS,
+    SIZE,
+    STATUS,
+    OTHER
+};
+enum class SchemaMember { NONE, NAME, TYPE, OTHER };
+enum class ScalarType { STRING, INTEGER, NUMBER, OTHER };
+
+// Nesting depth of the values the handler cares about
+const size_t ROOT_DEPTH = 1;  // root object
+const size_t LIST_DEPTH = 2;  // schema / datarows arrays
+const size_t ITEM_DEPTH = 3;  // schema entries / datarows rows
+
+// Decodes a plain decimal integer, false if the text is anything else or
+// does not fit
+bool ParseInteger(const char* str, size_t length, int64_t& value) {
+    const bool negative = (length > 0 && str[0] == '-');
+    size_t i = negative ? 1 : 0;
+    if (i == length)
+        return false;
+    uint64_t magnitude = 0;
+    const uint64_t limit =
+        static_cast< uint64_t >(std::numeric_limits< int64_t >::max())
+        + (negative ? 1 : 0);
+    for (; i < length; i++) {
+        if (str[i] < '0' || str[i] > '9')
+            return false;
+        const uint64_t digit = static_cast< uint64_t >(str[i] - '0');
+        if (magnitude > (limit - digit) / 10)
+            return false;
+        magnitude = magnitude * 10 + digit;
+    }
+    value = negative ? static_cast< int64_t >(0 - magnitude)
+                     : static_cast< int64_t >(magnitude);
+    return true;
+}
+
+// Receives the single number of a datarows cell that is not a plain integer.
+// rapidjson's conversion does not depend on the C locale, unlike strtod.
+class NumberHandler
+    : public rapidjson::BaseReaderHandler< rapidjson::UTF8<>, NumberHandler > {
+   public:
+    bool Int(int i) {
+        value = i;
+        return true;
+    }
+    bool Uint(unsigned u) {
+        value = u;
+        return true;
+    }
+    bool Int64(int64_t i) {
+        value = static_cast< double >(i);
+        return true;
+    }
+    bool Uint64(uint64_t u) {
+        value = static_cast< double >(u);
+        return true;
+    }
+    bool Double(double d) {
+        value = d;
+        return true;
+    }
+
+    double value = 0;
+};
+
+class ResponseHandler
+    : public rapidjson::BaseReaderHandler< rapidjson::UTF8<>,
+                                           ResponseHandler > {
+   public:
+    explicit ResponseHandler(OpenSearchResult& result)
+        : m_result(result),
+          m_body(result.result_json.data()),
+          m_depth(0),
+          m_member(ResponseMember::NONE),
+          m_schema_member(SchemaMember::NONE),
+          m_has_name(false),
+          m_has_type(false),
+          m_seen_members(0),
+          m_row_cells(0),
+          m_writer(m_nested) {
+    }
+
+    bool Null() {
+        if (InNestedCell())
+            return m_writer.Null();
+        if (InRow()) {
+            DataCell cell;
+            cell.offset = 0;
+            cell.length = -1;
+            cell.type = CellType::TEXT;
+            cell.in_body = false;
+            cell.integer = 0;
+            m_result.datarows.push_back(cell);
+            ++m_row_cells;
+            return true;
+        }
+        return Scalar(ScalarType::OTHER, NULL, 0);
+    }
+
+    bool Bool(bool b) {
+        if (InNestedCell())
+            return m_writer.Bool(b);
+        if (InRow()) {
+            if (!(b ? AppendCell("true", 4) : AppendCell("false", 5)))
+                return false;
+            m_result.datarows.back().type = CellType::BOOL;
+            m_result.datarows.back().integer = b ? 1 : 0;
+            return true;
+        }
+        return Scalar(ScalarType::OTHER, NULL, 0);
+    }
+
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
+        (void)copy;
+        if (InNestedCell())
+            return m_writer.RawValue(str, length, rapidjson::kNumberType);
+        if (InRow())
+            return AppendNumberCell(str, length);
+        return Scalar(IsInteger(str, length) ? ScalarType::INTEGER
+                                             : ScalarType::NUMBER,
+                      str, length);
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool copy) {
+        (void)copy;
+        if (InNestedCell())
+            return m_writer.String(str, length);
+        if (InRow())
+            return AppendBodyCell(str, length);
+        return Scalar(ScalarType::STRING, str, length);
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+        (void)copy;
+        if (m_depth == ROOT_DEPTH) {
+            m_member = ToResponseMember(std::string(str, length));
+            m_seen_members |= (1u << static_cast< unsigned >(m_member));
+        } else if (m_member == ResponseMember::SCHEMA
+                   && m_depth == ITEM_DEPTH) {
+            std::string key(str, length);
+            m_schema_member = (key == "name")
+                                  ? SchemaMember::NAME
+                                  : ((key == "type") ? SchemaMember::TYPE
+                                                     : SchemaMember::OTHER);
+        } else if (InNestedCell()) {
+            return m_writer.Key(str, length);
+        }
+        return true;
+    }
+
+    bool StartObject() {
+        if (!StartContainer(true))
+            return false;
+        ++m_depth;
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType member_count) {
+        (void)member_count;
+        size_t closing = m_depth--;
+        if (m_member == ResponseMember::DATAROWS && closing > ITEM_DEPTH)
+            return EndNested(m_writer.EndObject());
+        if (m_member == ResponseMember::SCHEMA && closing == ITEM_DEPTH) {
+            if (!m_has_name || !m_has_type)
+                return Fail("'schema' entries require 'name' and 'type'.");
+            m_result.schema.push_back(
+                std::make_pair(m_column_name, m_column_type));
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        if (!StartContainer(false))
+            return false;
+        ++m_depth;
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType element_count) {
+        (void)element_count;
+        size_t closing = m_depth--;
+        if (m_member != ResponseMember::DATAROWS)
+            return true;
+        if (closing > ITEM_DEPTH)
+            return EndNested(m_writer.EndArray());
+        if (closing == ITEM_DEPTH) {
+            if (m_result.num_rows == 0)
+                m_result.row_width = m_row_cells;
+            else if (m_row_cells != m_result.row_width)
+                return Fail("Rows in 'datarows' have different lengths.");
+            m_result.num_rows++;
+            m_row_cells = 0;
+        }
+        return true;
+    }
+
+    void CheckRequiredMembers(bool is_cursor_page) const {
+        static const std::vector< std::pair< ResponseMember, std::string > >
+            query_members = {{ResponseMember::SCHEMA, "schema"},
+                             {ResponseMember::TOTAL, "total"},
+                             {ResponseMember::DATAROWS, "datarows"},
+                             {ResponseMember::SIZE, "size"},
+                             {ResponseMember::STATUS, "status"}};
+        static const std::vector< std::pair< ResponseMember, std::string > >
+            cursor_members = {{ResponseMember::DATAROWS, "datarows"}};
+        for (auto& it : is_cursor_page ? cursor_members : query_members) {
+            if (!(m_seen_members & (1u << static_cast< unsigned >(it.first))))
+                throw std::runtime_error("Required member '" + it.second
+                                         + "' is missing from the response.");
+        }
+    }
+
+    const std::string& GetError() const {
+        return m_error;
+    }
+
+   private:
+    static ResponseMember ToResponseMember(const std::string& key) {
+        if (key == "schema")
+            return ResponseMember::SCHEMA;
+        if (key == "cursor")
+            return ResponseMember::CURSOR;
+        if (key == "total")
+            return ResponseMember::TOTAL;
+        if (key == "datarows")
+            return ResponseMember::DATAROWS;
+        if (key == "size")
+            return ResponseMember::SIZE;
+        if (key == "status")
+            return ResponseMember::STATUS;
+        return ResponseMember::OTHER;
+    }
+
+    static bool IsInteger(const char* str, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            if (str[i] == '.' || str[i] == 'e' || str[i] == 'E')
+                return false;
+        }
+        return true;
+    }
+
+    bool InRow() const {
+        return m_member == ResponseMember::DATAROWS && m_depth == ITEM_DEPTH;
+    }
+
+    bool InNestedCell() const {
+        return m_member == ResponseMember::DATAROWS && m_depth > ITEM_DEPTH;
+    }
+
+    bool Fail(const std::string& error) {
+        m_error = error;
+        return false;
+    }
+
+    // Plain integers are decoded by ParseInteger, anything else goes through
+    // a reader bounded to the number text, which insitu parsing does not
+    // terminate. A number that cannot be decoded stays a text cell.
+    bool AppendNumberCell(const char* str, size_t length) {
+        if (!AppendBodyCell(str, length))
+            return false;
+        DataCell& cell = m_result.datarows.back();
+        if (ParseInteger(str, length, cell.integer)) {
+            cell.type = CellType::INTEGER;
+            return true;
+        }
+        rapidjson::MemoryStream number(str, length);
+        if (m_number_reader.Parse< NUMBER_PARSE_FLAGS >(number,
+                                                         m_number_handler)) {
+            cell.type = CellType::DOUBLE;
+            cell.number = m_number_handler.value;
+        }
+        return true;
+    }
+
+    // Strings and numbers are left where the insitu parse decoded them
+    bool AppendBodyCell(const char* str, size_t length) {
+        PushCell(static_cast< size_t >(str - m_body), length, true);
+        return true;
+    }
+
+    bool AppendCell(const char* str, size_t length) {
+        size_t offset = m_result.cell_data.size();
+        m_result.cell_data.append(str, length);
+        PushCell(offset, length, false);
+        return true;
+    }
+
+    void PushCell(size_t offset, size_t length, bool in_body) {
+        DataCell cell;
+        cell.offset = offset;
+        cell.length = static_cast< int32_t >(length);
+        cell.type = CellType::TEXT;
+        cell.in_body = in_body;
+        cell.integer = 0;
+        m_result.datarows.push_back(cell);
+        m_result.text_size += length + 1;
+        ++m_row_cells;
+    }
+
+    // Objects and arrays inside a row are kept as their JSON text, the same
+    // way the DOM path stringifies them
+    bool EndNested(bool written) {
+        if (!written)
+            return Fail("Failed to write nested datarows value.");
+        if (m_depth != ITEM_DEPTH)
+            return true;
+        return AppendCell(m_nested.GetString(), m_nested.GetSize());
+    }
+
+    bool StartContainer(bool is_object) {
+        if (m_depth == 0)
+            return is_object ? true : Fail("Response is not a JSON object.");
+        if (m_depth == ROOT_DEPTH) {
+            switch (m_member) {
+                case ResponseMember::SCHEMA:
+                case ResponseMember::DATAROWS:
+                    return is_object ? Fail("Expected an array for member '"
+                                            + MemberName() + "'.")
+                                     : true;
+                case ResponseMember::OTHER:
+                    return true;
+                default:
+                    return Fail(std::string("Unexpected ")
+                                + (is_object ? "object" : "array")
+                                + " for member '" + MemberName() + "'.");
+            }
+        }
+        if (m_member == ResponseMember::SCHEMA && m_depth == LIST_DEPTH) {
+            if (!is_object)
+                return Fail("'schema' entries must be objects.");
+            m_column_name.clear();
+            m_column_type.clear();
+            m_has_name = false;
+            m_has_type = false;
+            m_schema_member = SchemaMember::NONE;
+        } else if (m_member == ResponseMember::DATAROWS) {
+            if (m_depth == LIST_DEPTH) {
+                if (is_object)
+                    return Fail("'datarows' entries must be arrays.");
+                m_row_cells = 0;
+            } else {
+                if (m_depth == ITEM_DEPTH) {
+                    m_nested.Clear();
+                    m_writer.Reset(m_nested);
+                }
+                return is_object ? m_writer.StartObject()
+                                 : m_writer.StartArray();
+            }
+        }
+        return true;
+    }
+
+    bool Scalar(ScalarType type, const char* str, size_t length) {
+        if (m_depth == 0)
+            return Fail("Response is not a JSON object.");
+        if (m_depth == ROOT_DEPTH) {
+            switch (m_member) {
+                case ResponseMember::SCHEMA:
+                case ResponseMember::DATAROWS:
+                    return Fail("Expected an array for member '"
+                                + MemberName() + "'.");
+                case ResponseMember::CURSOR:
+                    if (type != ScalarType::STRING)
+                        return Fail("Expected a string for member 'cursor'.");
+                    m_result.cursor.assign(str, length);
+                    return true;
+                case ResponseMember::TOTAL:
+                case ResponseMember::SIZE:
+                case ResponseMember::STATUS:
+                    if (type != ScalarType::INTEGER)
+                        return Fail("Expected an integer for member '"
+                                    + MemberName() + "'.");
+                    return true;
+                default:
+                    return true;
+            }
+        }
+        if (m_member == ResponseMember::SCHEMA) {
+            if (m_depth == LIST_DEPTH)
+                return Fail("'schema' entries must be objects.");
+            if (m_depth == ITEM_DEPTH
+                && (m_schema_member == SchemaMember::NAME
+                    || m_schema_member == SchemaMember::TYPE)) {
+                if (type != ScalarType::STRING)
+                    return Fail("Expected a string for 'schema' entry member.");
+                if (m_schema_member == SchemaMember::NAME) {
+                    m_column_name.assign(str, length);
+                    m_has_name = true;
+                } else {
+                    m_column_type.assign(str, length);
+                    m_has_type = true;
+                }
+            }
+        } else if (m_member == ResponseMember::DATAROWS
+                   && m_depth == LIST_DEPTH) {
+            return Fail("'datarows' entries must be arrays.");
+        }
+        return true;
+    }
+
+    std::string MemberName() const {
+        switch (m_member) {
+            case ResponseMember::SCHEMA:
+                return "schema";
+            case ResponseMember::CURSOR:
+                return "cursor";
+            case ResponseMember::TOTAL:
+                return "total";
+            case ResponseMember::DATAROWS:
+                return "datarows";
+            case ResponseMember::SIZE:
+                return "size";
+            case ResponseMember::STATUS:
+                return "status";
+            default:
+                return "";
+        }
+    }
+
+    OpenSearchResult& m_result;
+    const char* m_body;
+    size_t m_depth;
+    ResponseMember m_member;
+    SchemaMember m_schema_member;
+    bool m_has_name;
+    bool m_has_type;
+    unsigned m_seen_members;
+    size_t m_row_cells;
+    std::string m_column_name;
+    std::string m_column_type;
+    std::string m_error;
+    rapidjson::StringBuffer m_nested;
+    rapidjson::Writer< rapidjson::StringBuffer > m_writer;
+    rapidjson::Reader m_number_reader;
+    NumberHandler m_number_handler;
+};
+
+class CursorHandler
+    : public rapidjson::BaseReaderHandler< rapidjson::UTF8<>, CursorHandler > {
+   public:
+    bool Default() {
+        m_at_cursor = false;
+        return true;
+    }
+
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
+        (void)str;
+        (void)length;
+        (void)copy;
+        return Default();
+    }
+
+    bool String(const char* str, rapidjson::SizeType length, bool copy) {
+        (void)copy;
+        if (m_at_cursor) {
+            cursor.assign(str, length);
+            return false;  // stop reading, the rest is left to the decoder
+        }
+        return true;
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+        (void)copy;
+        m_at_cursor = (m_depth == ROOT_DEPTH && length == 6
+                       && std::char_traits< char >::compare(str, "cursor", 6)
+                              == 0);
+        return true;
+    }
+
+    bool StartObject() {
+        ++m_depth;
+        return Default();
+    }
+
+    bool EndObject(rapidjson::SizeType member_count) {
+        (void)member_count;
+        --m_depth;
+        return Default();
+    }
+
+    bool StartArray() {
+        ++m_depth;
+        return Default();
+    }
+
+    bool EndArray(rapidjson::SizeType element_count) {
+        (void)element_count;
+        --m_depth;
+        return Default();
+    }
+
+    std::string cursor;
+
+   private:
+    size_t m_depth = 0;
+    bool m_at_cursor = false;
+};
+
+void ParseResponse(OpenSearchResult& opensearch_result, bool is_cursor_page) {
+    opensearch_result.streamed = true;
+    opensearch_result.schema.clear();
+    opensearch_result.datarows.clear();
+    opensearch_result.cell_data.clear();
+    opensearch_result.text_size = 0;
+    opensearch_result.num_rows = 0;
+    opensearch_result.row_width = 0;
+
+    // Strings are unescaped inside result_json itself, the cells keep
+    // pointing at them
+    ResponseHandler handler(opensearch_result);
+    rapidjson::Reader reader;
+    rapidjson::InsituStringStream stream(&opensearch_result.result_json[0]);
+    rapidjson::ParseResult ok =
+        reader.Parse< PARSE_FLAGS | rapidjson::kParseInsituFlag >(stream,
+                                                                 handler);
+    if (!ok) {
+        // Decoded strings were terminated in place, keep the body printable
+        std::replace(opensearch_result.result_json.begin(),
+                     opensearch_result.result_json.end(), '\0', ' ');
+        // The handler message is more useful than 'Terminate parsing due to
+        // Handler error.' - prefer it when present
+        std::string error = handler.GetError().empty()
+                                 ? rapidjson::GetParseError_En(ok.Code())
+                                 : handler.GetError();
+        throw std::runtime_error("Exception obtained '" + error
+                                 + "' at offset " + std::to_string(ok.Offset())
+                                 + " when parsing json string '"
+                                 + opensearch_result.result_json + "'.");
+    }
+    handler.CheckRequiredMembers(is_cursor_page);
+}
+
+enum class FlatColumn { TEXT, NUMBER, BOOL, UNSUPPORTED };
+
+// Objects and arrays are printed differently by the flat formats than by the
+// JDBC one, their columns keep the JDBC format
+FlatColumn ToFlatColumn(const std::string& type) {
+    if (type == "byte" || type == "short" || type == "integer"
+        || type == "long" || type == "float" || type == "half_float"
+        || type == "scaled_float" || type == "double")
+        return FlatColumn::NUMBER;
+    if (type == "boolean")
+        return FlatColumn::BOOL;
+    if (type == "keyword" || type == "text" || type == "string"
+        || type == "date" || type == "time" || type == "timestamp"
+        || type == "datetime" || type == "ip")
+        return FlatColumn::TEXT;
+    return FlatColumn::UNSUPPORTED;
+}
+
+// Splits a flat response into cells in place. The server quotes a cell that
+// holds the separator and doubles the quotes inside it, any other cell is
+// sent as it is. Lines end with '\n' or "\r\n".
+class DelimitedReader {
+   public:
+    DelimitedReader(std::string& body, char separator)
+        : m_body(&body[0]),
+          m_size(body.size()),
+          m_pos(0),
+          m_separator(separator) {
+    }
+
+    bool AtEnd() const {
+        return m_pos >= m_size;
+    }
+
+    // Reads the next cell of the current line. Returns true if it was the
+    // last one of the line.
+    bool ReadCell(size_t& offset, size_t& length) {
+        if (m_pos >= m_size || m_body[m_pos] != '"'
+            || !ReadQuoted(offset, length))
+            ReadPlain(offset, length);
+        if (m_pos < m_size && m_body[m_pos] == m_separator) {
+            ++m_pos;
+            return false;
+        }
+        if (m_pos < m_size && m_body[m_pos] == '\r')
+            ++m_pos;
+        if (m_pos < m_size && m_body[m_pos] == '\n')
+            ++m_pos;
+        return true;
+    }
+
+   private:
+    bool IsCellEnd(size_t pos) const {
+        return pos >= m_size || m_body[pos] == m_separator
+               || m_body[pos] == '\n'
+               || (m_body[pos] == '\r'
+                   && (pos + 1 >= m_size || m_body[pos + 1] == '\n'));
+    }
+
+    void ReadPlain(size_t& offset, size_t& length) {
+        offset = m_pos;
+        while (!IsCellEnd(m_pos))
+            ++m_pos;
+        length = m_pos - offset;
+    }
+
+    // A plain cell may start with a quote too. The cell is only unquoted if
+    // its closing quote ends it, otherwise nothing is changed.
+    bool ReadQuoted(size_t& offset, size_t& length) {
+        size_t end = m_pos + 1;
+        size_t doubled = 0;
+        while (end < m_size) {
+            if (m_body[end] == '"') {
+                if (end + 1 < m_size && m_body[end + 1] == '"') {
+                    end += 2;
+                    ++doubled;
+                    continue;
+                }
+                break;
+            }
+            ++end;
+        }
+        if (end >= m_size || !IsCellEnd(end + 1))
+            return false;
+
+        offset = m_pos + 1;
+        length = end - offset - doubled;
+        for (size_t in = offset, out = offset; doubled > 0 && in < end;
+             ++in, ++out) {
+            m_body[out] = m_body[in];
+            if (m_body[in] == '"')
+                ++in;
+        }
+        m_pos = end + 1;
+        return true;
+    }
+
+    char* m_body;
+    const size_t m_size;
+    size_t m_pos;
+    const char m_separator;
+};
+
+// Cells are typed by their column, so numeric and boolean binds can skip
+// parsing the text again like they do for JDBC responses
+void PushFlatCell(OpenSearchResult& opensearch_result, FlatColumn column,
+                  size_t offset, size_t length, rapidjson::Reader& reader,
+                  NumberHandler& handler) {
+    DataCell cell;
+    cell.offset = 0;
+    cell.length = -1;
+    cell.type = CellType::TEXT;
+    cell.in_body = false;
+    cell.integer = 0;
+    if (length == 0) {
+        opensearch_result.datarows.push_back(cell);
+        return;
+    }
+
+    const char* str = opensearch_result.result_json.data() + offset;
+    cell.offset = offset;
+    cell.length = static_cast< int32_t >(length);
+    cell.in_body = true;
+    if (column == FlatColumn::NUMBER) {
+        if (ParseInteger(str, length, cell.integer)) {
+            cell.type = CellType::INTEGER;
+        } else {
+            rapidjson::MemoryStream number(str, length);
+            if (reader.Parse< NUMBER_PARSE_FLAGS >(number, handler)) {
+                cell.type = CellType::DOUBLE;
+                cell.number = handler.value;
+            }
+        }
+    } else if (column == FlatColumn::BOOL) {
+        if (length == 4 && memcmp(str, "true", 4) == 0) {
+            cell.type = CellType::BOOL;
+            cell.integer = 1;
+        } else if (length == 5 && memcmp(str, "false", 5) == 0) {
+            cell.type = CellType::BOOL;
+        }
+    }
+    opensearch_result.datarows.push_back(cell);
+    opensearch_result.text_size += length + 1;
+}
+}  // namespace
+
+void ParseQueryResponse(OpenSearchResult& opensearch_result) {
+    ParseResponse(opensearch_result, false);
+}
+
+void ParseCursorResponse(OpenSearchResult& opensearch_result) {
+    ParseResponse(opensearch_result, true);
+}
+
+std::string ReadResponseCursor(const std::string& response) {
+    CursorHandler handler;
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(response.c_str());
+    reader.Parse< PARSE_FLAGS >(stream, handler);
+    return handler.cursor;
+}
+
+bool IsFlatFormatType(const std::string& type) {
+    return ToFlatColumn(type) != FlatColumn::UNSUPPORTED;
+}
+
+void ParseDelimitedResponse(OpenSearchResult& opensearch_result,
+                            char separator) {
+    opensearch_result.streamed = true;
+    opensearch_result.datarows.clear();
+    opensearch_result.cell_data.clear();
+    opensearch_result.text_size = 0;
+    opensearch_result.num_rows = 0;
+    opensearch_result.row_width = opensearch_result.schema.size();
+
+    const size_t width = opensearch_result.row_width;
+    if (width == 0)
+        throw std::runtime_error("No schema for the delimited response.");
+    std::vector< FlatColumn > columns;
+    for (auto& column : opensearch_result.schema)
+        columns.push_back(ToFlatColumn(column.second));
+
+    // Every line after the header is a row
+    std::string& body = opensearch_result.result_json;
+    opensearch_result.datarows.reserve(
+        static_cast< size_t >(std::count(body.begin(), body.end(), '\n'))
+        * width);
+    DelimitedReader reader(body, separator);
+    rapidjson::Reader number_reader;
+    NumberHandler number_handler;
+    size_t line = 1;
+    size_t cells = 0;
+    size_t offset = 0;
+    size_t length = 0;
+    // The header only names the columns, the schema types them
+    bool last = false;
+    while (!last) {
+        last = reader.ReadCell(offset, length);
+        ++cells;
+    }
+    while (cells == width && !reader.AtEnd()) {
+        ++line;
+        cells = 0;
+        last = false;
+        while (!last && cells < width) {
+            last = reader.ReadCell(offset, length);
+            PushFlatCell(opensearch_result, columns[cells], offset, length,
+                         number_reader, number_handler);
+            ++cells;
+        }
+        if (!last)
+            ++cells;
+        else
+            ++opensearch_result.num_rows;
+    }
+    if (cells != width) {
+        throw std::runtime_error(
+            "Expected " + std::to_string(width) + " values on line "
+            + std::to_string(line) + " of the delimited response, found "
+            + (cells > width ? "more" : std::to_string(cells)) + ".");
+    }
+}
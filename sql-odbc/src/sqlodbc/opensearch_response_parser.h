@@ -0,0 +1,39 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef __OPENSEARCH_RESPONSE_PARSER_H__
+#define __OPENSEARCH_RESPONSE_PARSER_H__
+
+#include "opensearch_types.h"
+
+// Single pass (SAX) parsers for JDBC formatted responses. The layout of the
+// schema, cursor and datarows members is checked while reading and the
+// streamed members of opensearch_result are filled without building a DOM.
+// result_json is decoded in place and the cells refer to it, so it must not be
+// changed afterwards. Both throw std::runtime_error if the response is
+// malformed.
+void ParseQueryResponse(OpenSearchResult& opensearch_result);
+void ParseCursorResponse(OpenSearchResult& opensearch_result);
+
+// Decoder for the delimited text of the csv and raw response formats: a
+// header line, then a line per row with its cells split by separator. The
+// columns and their types are taken from opensearch_result.schema, which the
+// caller fills beforehand. Empty cells are NULL. Like the JSON parsers it
+// unquotes the cells in place and they refer to result_json. Throws
+// std::runtime_error if a line does not have a cell per column.
+void ParseDelimitedResponse(OpenSearchResult& opensearch_result,
+                            char separator);
+// Whether the delimited formats print the values of a column of this type
+// the same way as the JDBC format
+bool IsFlatFormatType(const std::string& type);
+
+// Reads only the root 'cursor' member of a response and stops as soon as it
+// is found, so the next page can be requested before this one is decoded.
+// Returns an empty string if there is no cursor or the response is malformed,
+// the full parse reports the error.
+std::string ReadResponseCursor(const std::string& response);
+
+#endif  // __OPENSEARCH_RESPONSE_PARSER_H__
@@ -0,0 +1,141 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "opensearch_result_cache.h"
+
+#include <cctype>
+
+#include "opensearch_types.h"
+
+std::shared_ptr< const OpenSearchResultCache::Pages > OpenSearchResultCache::get(
+    const std::string& key, std::chrono::seconds ttl) {
+    std::scoped_lock lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found == m_index.end()) {
+        m_metrics.misses++;
+        return nullptr;
+    }
+
+    auto entry = found->second;
+    if (std::chrono::steady_clock::now() - entry->stored > ttl) {
+        erase(entry);
+        m_metrics.misses++;
+        m_metrics.expiries++;
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, entry);
+    m_metrics.hits++;
+    return entry->pages;
+}
+
+void OpenSearchResultCache::put(const std::string& key,
+                                std::shared_ptr< const Pages > pages,
+                                size_t bytes, size_t budget) {
+    std::scoped_lock lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found != m_index.end()) {
+        erase(found->second);
+    }
+    if (bytes > budget) {
+        return;
+    }
+
+    m_lru.push_front(
+        {key, std::move(pages), bytes, std::chrono::steady_clock::now()});
+    m_index[key] = m_lru.begin();
+    m_metrics.bytes += bytes;
+    m_metrics.entries++;
+    while (m_metrics.bytes > budget) {
+        erase(std::prev(m_lru.end()));
+        m_metrics.evictions++;
+    }
+}
+
+void OpenSearchResultCache::clear() {
+    std::scoped_lock lock(m_mutex);
+    m_lru.clear();
+    m_index.clear();
+    m_metrics.bytes = 0;
+    m_metrics.entries = 0;
+}
+
+query_cache_metrics OpenSearchResultCache::metrics() {
+    std::scoped_lock lock(m_mutex);
+    return m_metrics;
+}
+
+void OpenSearchResultCache::erase(std::list< Entry >::iterator entry) {
+    m_metrics.bytes -= entry->bytes;
+    m_metrics.entries--;
+    m_index.erase(entry->key);
+    m_lru.erase(entry);
+}
+
+OpenSearchResultCache& QueryResultCache() {
+    static OpenSearchResultCache cache;
+    return cache;
+}
+
+size_t CachedPageSize(const OpenSearchResult& page) {
+    size_t size = sizeof(OpenSearchResult) + page.result_json.capacity()
+                  + page.cell_data.capacity() + page.cursor.capacity()
+                  + page.datarows.capacity() * sizeof(DataCell)
+                  + page.column_info.capacity() * sizeof(ColumnInfo);
+    for (const auto& column : page.schema) {
+        size += sizeof(column) + column.first.capacity()
+                + column.second.capacity();
+    }
+    return size;
+}
+
+std::unique_ptr< OpenSearchResult > CopyCachedPage(
+    const OpenSearchResult& page) {
+    std::unique_ptr< OpenSearchResult > copy =
+        std::make_unique< OpenSearchResult >();
+    copy->num_fields = page.num_fields;
+    copy->column_info = page.column_info;
+    copy->cursor = page.cursor;
+    copy->result_json = page.result_json;
+    copy->command_type = page.command_type;
+    copy->streamed = page.streamed;
+    copy->schema = page.schema;
+    copy->datarows = page.datarows;
+    copy->cell_data = page.cell_data;
+    copy->text_size = page.text_size;
+    copy->num_rows = page.num_rows;
+    copy->row_width = page.row_width;
+    return copy;
+}
+
+std::string NormalizeStatement(const std::string& statement) {
+    std::string normalized;
+    normalized.reserve(statement.size());
+    char quote = '\0';
+    bool space = false;
+    for (char c : statement) {
+        if (quote == '\0' && std::isspace(static_cast< unsigned char >(c))) {
+            space = !normalized.empty();
+            continue;
+        }
+        if (space) {
+            normalized.push_back(' ');
+            space = false;
+        }
+        if (quote == '\0' && (c == '\'' || c == '"' || c == '`')) {
+            quote = c;
+        } else if (c == quote) {
+            quote = '\0';
+        }
+        normalized.push_back(c);
+    }
+    if (quote == '\0' && !normalized.empty() && normalized.back() == ';') {
+        normalized.pop_back();
+        while (!normalized.empty() && normalized.back() == ' ') {
+            normalized.pop_back();
+        }
+    }
+    return normalized;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef OPENSEARCH_RESULT_CACHE
+#define OPENSEARCH_RESULT_CACHE
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct OpenSearchResult;
+
+// Counters of the query result cache. A lookup of an entry older than the
+// caller's TTL counts as a miss and an expiry, evictions are entries dropped
+// to stay within the memory budget.
+typedef struct query_cache_metrics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t expiries = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+} query_cache_metrics;
+
+// Decoded result pages of complete queries, shared by every connection of the
+// driver. Stored pages are never modified, readers copy the ones they hand
+// to a statement.
+class OpenSearchResultCache {
+    public:
+        typedef std::vector< std::shared_ptr< const OpenSearchResult > > Pages;
+
+        // Returns NULL if there is no entry for key younger than ttl.
+        std::shared_ptr< const Pages > get(const std::string& key,
+                                           std::chrono::seconds ttl);
+        // Replaces the entry for key, then drops the least recently used
+        // entries until the cache fits in budget bytes.
+        void put(const std::string& key, std::shared_ptr< const Pages > pages,
+                 size_t bytes, size_t budget);
+        void clear();
+        query_cache_metrics metrics();
+
+    private:
+        struct Entry {
+            std::string key;
+            std::shared_ptr< const Pages > pages;
+            size_t bytes;
+            std::chrono::steady_clock::time_point stored;
+        };
+        void erase(std::list< Entry >::iterator entry);
+
+        std::list< Entry > m_lru;  // most recently used first
+        std::unordered_map< std::string, std::list< Entry >::iterator > m_index;
+        std::mutex m_mutex;
+        query_cache_metrics m_metrics;
+};
+
+OpenSearchResultCache& QueryResultCache();
+
+// Memory a decoded streamed page takes, as counted against the budget.
+size_t CachedPageSize(const OpenSearchResult& page);
+// Copy of a streamed page, the cells refer to the copied text.
+std::unique_ptr< OpenSearchResult > CopyCachedPage(const OpenSearchResult& page);
+// Statement text with runs of whitespace outside quotes collapsed and the
+// trailing semicolon removed, so trivially different texts share an entry.
+std::string NormalizeStatement(const std::string& statement);
+
+#endif
@@ -9,46 +9,92 @@
 #include "opensearch_types.h"
 
 OpenSearchResultQueue::OpenSearchResultQueue(unsigned int capacity)
-    : m_push_semaphore(capacity, capacity),
-      m_pop_semaphore(0, capacity) {
+    : m_capacity(capacity > 0 ? capacity : 1),
+      m_closed(true),
+      m_cancelled(false) {
 }
 
 OpenSearchResultQueue::~OpenSearchResultQueue() {
-    while (!m_queue.empty()) {
-        delete m_queue.front();
-        m_queue.pop();
-    }
+    clear_locked();
+}
+
+void OpenSearchResultQueue::reset() {
+    std::scoped_lock lock(m_queue_mutex);
+    m_closed = false;
+    m_cancelled = false;
 }
 
 void OpenSearchResultQueue::clear() {
     std::scoped_lock lock(m_queue_mutex);
-    while (!m_queue.empty()) {
-        delete m_queue.front();
-        m_queue.pop();
-        m_push_semaphore.release();
-        m_pop_semaphore.lock();
+    clear_locked();
+    m_not_full.notify_all();
+}
+
+bool OpenSearchResultQueue::push(OpenSearchResult* result) {
+    std::unique_lock< std::mutex > lock(m_queue_mutex);
+    m_not_full.wait(lock, [this]() {
+        return m_cancelled || m_queue.size() < m_capacity;
+    });
+    if (m_cancelled) {
+        return false;
     }
+    m_queue.push(result);
+    m_not_empty.notify_one();
+    return true;
 }
 
-bool OpenSearchResultQueue::pop(unsigned int timeout_ms, OpenSearchResult*& result) {
-    if (m_pop_semaphore.try_lock_for(timeout_ms)) {
-        std::scoped_lock lock(m_queue_mutex);
-        result = m_queue.front();
-        m_queue.pop();
-        m_push_semaphore.release();
-        return true;
+bool OpenSearchResultQueue::try_push(OpenSearchResult* result) {
+    std::scoped_lock lock(m_queue_mutex);
+    if (m_cancelled || m_queue.size() >= m_capacity) {
+        return false;
     }
+    m_queue.push(result);
+    m_not_empty.notify_one();
+    return true;
+}
 
-    return false;
+bool OpenSearchResultQueue::pop(OpenSearchResult*& result) {
+    std::unique_lock< std::mutex > lock(m_queue_mutex);
+    m_not_empty.wait(lock, [this]() {
+        return m_cancelled || m_closed || !m_queue.empty();
+    });
+    if (m_cancelled || m_queue.empty()) {
+        return false;
+    }
+    result = m_queue.front();
+    m_queue.pop();
+    m_not_full.notify_one();
+    return true;
 }
 
-bool OpenSearchResultQueue::push(unsigned int timeout_ms, OpenSearchResult* result) {
-    if (m_push_semaphore.try_lock_for(timeout_ms)) {
-        std::scoped_lock lock(m_queue_mutex);
-        m_queue.push(result);
-        m_pop_semaphore.release();
-        return true;
+bool OpenSearchResultQueue::try_pop(OpenSearchResult*& result) {
+    std::scoped_lock lock(m_queue_mutex);
+    if (m_cancelled || m_queue.empty()) {
+        return false;
     }
+    result = m_queue.front();
+    m_queue.pop();
+    m_not_full.notify_one();
+    return true;
+}
+
+void OpenSearchResultQueue::close() {
+    std::scoped_lock lock(m_queue_mutex);
+    m_closed = true;
+    m_not_empty.notify_all();
+}
 
-    return false;
+void OpenSearchResultQueue::cancel() {
+    std::scoped_lock lock(m_queue_mutex);
+    clear_locked();
+    m_cancelled = true;
+    m_not_full.notify_all();
+    m_not_empty.notify_all();
+}
+
+void OpenSearchResultQueue::clear_locked() {
+    while (!m_queue.empty()) {
+        delete m_queue.front();
+        m_queue.pop();
+    }
 }
@@ -6,29 +6,48 @@
 #ifndef OPENSEARCH_RESULT_QUEUE
 #define OPENSEARCH_RESULT_QUEUE
 
+#include <condition_variable>
 #include <mutex>
 #include <queue>
 
-#include "opensearch_semaphore.h"
-
-#define QUEUE_TIMEOUT 20 // milliseconds
-
 struct OpenSearchResult;
 
+// Bounded queue handing result pages from the retrieval threads to the
+// statement. Waiting calls block until they can proceed or the queue is
+// closed or cancelled, they never poll.
 class OpenSearchResultQueue {
     public:
         OpenSearchResultQueue(unsigned int capacity);
         ~OpenSearchResultQueue();
 
+        // Opens the queue for the pages of a new query. It starts closed, so
+        // popping before the first query does not block.
+        void reset();
         void clear();
-        bool pop(unsigned int timeout_ms, OpenSearchResult*& result);
-        bool push(unsigned int timeout_ms, OpenSearchResult* result);
+        // Blocks while the queue is full. Returns false if it was cancelled,
+        // the caller keeps ownership of result then.
+        bool push(OpenSearchResult* result);
+        bool try_push(OpenSearchResult* result);
+        // Blocks until a page is available. Returns false once the queue is
+        // closed and drained, or cancelled.
+        bool pop(OpenSearchResult*& result);
+        bool try_pop(OpenSearchResult*& result);
+        // No more pages will be pushed, waiting consumers are woken.
+        void close();
+        // Drops the queued pages and wakes every waiting producer and
+        // consumer. Pushes fail until the next reset.
+        void cancel();
 
     private:
+        void clear_locked();
+
+        const size_t m_capacity;
         std::queue< OpenSearchResult*> m_queue;
         std::mutex m_queue_mutex;
-        opensearch_semaphore m_push_semaphore;
-        opensearch_semaphore m_pop_semaphore;
+        std::condition_variable m_not_full;
+        std::condition_variable m_not_empty;
+        bool m_closed;
+        bool m_cancelled;
 };
 
 #endif
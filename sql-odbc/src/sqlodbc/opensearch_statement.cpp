@@ -6,25 +6,83 @@
 
 #include "opensearch_statement.h"
 
+#include <mutex>
+
 #include "environ.h"  // Critical section for statment
 #include "misc.h"
 #include "opensearch_apifunc.h"
+#include "opensearch_executor.h"
 #include "opensearch_helper.h"
 #include "statement.h"
 
 extern "C" void *common_cs;
 
+namespace {
+struct AsyncCall {
+    explicit AsyncCall(SQLUSMALLINT id) : function_id(id) {
+    }
+
+    ~AsyncCall() {
+        ER_Destructor(sequence_error);
+    }
+
+    const SQLUSMALLINT function_id;
+    std::mutex mutex;
+    bool done = false;
+    RETCODE ret = SQL_ERROR;
+    // HY010 of the last function rejected while the call is pending, kept
+    // apart from the diagnostics the call itself sets. Guarded by common_cs.
+    OpenSearch_ErrorInfo *sequence_error = NULL;
+};
+
+void ReleaseAsyncCall(StatementClass *stmt) {
+    ENTER_COMMON_CS;
+    AsyncCall *call = static_cast< AsyncCall * >(stmt->async_call);
+    stmt->async_call = NULL;
+    LEAVE_COMMON_CS;
+    delete call;
+}
+
+// Records the sequence error of a rejected function, common_cs held
+void SetSequenceError(StatementClass *stmt, AsyncCall *call) {
+    const char *sqlstate = "HY010";
+    ConnectionClass *conn = SC_get_conn(stmt);
+    if (conn != NULL) {
+        EnvironmentClass *env = (EnvironmentClass *)CC_get_env(conn);
+        if (!EN_is_odbc3(env))
+            sqlstate = "S1010";
+    }
+    ER_Destructor(call->sequence_error);
+    call->sequence_error = ER_Constructor(
+        STMT_SEQUENCE_ERROR,
+        "An asynchronously executing function was still running");
+    if (call->sequence_error != NULL)
+        STRCPY_FIXED(call->sequence_error->sqlstate, sqlstate);
+}
+
+// Takes the counters of the query from the connection after a page was added
+// to the tuple cache of res
+void UpdateMetrics(StatementClass *stmt, QResultClass *res,
+                   SQLULEN build_start) {
+    OpenSearchStatementMetrics *metrics = &stmt->metrics;
+    metrics->build_time_us += OpenSearchClockMicros() - build_start;
+    OpenSearchGetQueryMetrics(stmt->result_stream, metrics);
+    SQLULEN cache_bytes =
+        static_cast< SQLULEN >(res->arena.allocated)
+        + res->count_backend_allocated * res->num_fields * sizeof(TupleField);
+    if (cache_bytes > metrics->peak_cache_bytes)
+        metrics->peak_cache_bytes = cache_bytes;
+}
+}  // namespace
+
 RETCODE ExecuteStatement(StatementClass *stmt, BOOL commit) {
     CSTR func = "ExecuteStatement";
     int func_cs_count = 0;
     ConnectionClass *conn = SC_get_conn(stmt);
-    CONN_Status oldstatus = conn->status;
 
     auto CleanUp = [&]() -> RETCODE {
         SC_SetExecuting(stmt, FALSE);
         CLEANUP_FUNC_CONN_CS(func_cs_count, conn);
-        if (conn->status != CONN_DOWN)
-            conn->status = oldstatus;
         if (SC_get_errornumber(stmt) == STMT_OK)
             return SQL_SUCCESS;
         else if (SC_get_errornumber(stmt) < STMT_OK)
@@ -39,26 +97,28 @@ RETCODE ExecuteStatement(StatementClass *stmt, BOOL commit) {
         }
     };
 
+    // The statement is marked executing under the connection critical
+    // section, so SQLDisconnect sees it. The query itself goes out without
+    // holding it, the other statements of the connection run theirs
+    // meanwhile over their own streams.
     ENTER_INNER_CONN_CS(conn, func_cs_count);
-
-    if (conn->status == CONN_EXECUTING) {
-        SC_set_error(stmt, STMT_SEQUENCE_ERROR, "Connection is already in use.",
+    BOOL executing = SC_SetExecuting(stmt, TRUE);
+    LEAVE_INNER_CONN_CS(func_cs_count, conn);
+    if (!executing) {
+        SC_set_error(stmt, STMT_OPERATION_CANCELLED, "Cancel Request Accepted",
                      func);
         return CleanUp();
     }
 
-    if (!SC_SetExecuting(stmt, TRUE)) {
+    QResultClass *res = SendQueryGetResult(stmt, commit);
+    if (!res && (stmt->cancel_info & CancelRequestSet)) {
         SC_set_error(stmt, STMT_OPERATION_CANCELLED, "Cancel Request Accepted",
                      func);
         return CleanUp();
-    }
-
-    conn->status = CONN_EXECUTING;
-
-    QResultClass *res = SendQueryGetResult(stmt, commit);
-    if (!res) {
-        std::string es_conn_err = GetErrorMsg(SC_get_conn(stmt)->opensearchconn);
-        ConnErrorType es_err_type = GetErrorType(SC_get_conn(stmt)->opensearchconn);
+    } else if (!res) {
+        std::string es_conn_err = OpenSearchGetStreamError(stmt->result_stream);
+        ConnErrorType es_err_type =
+            OpenSearchGetStreamErrorType(stmt->result_stream);
         std::string es_parse_err = GetResultParserError();
         if (!es_conn_err.empty()) {
             if (es_err_type == ConnErrorType::CONN_ERROR_QUERY_SYNTAX) {
@@ -78,10 +138,7 @@ RETCODE ExecuteStatement(StatementClass *stmt, BOOL commit) {
         return CleanUp();
     }
 
-    if (CONN_DOWN != conn->status)
-        conn->status = oldstatus;
     stmt->status = STMT_FINISHED;
-    LEAVE_INNER_CONN_CS(func_cs_count, conn);
 
     // Check the status of the result
     if (SC_get_errornumber(stmt) < 0) {
@@ -137,8 +194,8 @@ RETCODE ExecuteStatement(StatementClass *stmt, BOOL commit) {
         SC_set_Result(stmt, res);
     }
 
-    // This will commit results for SQLExecDirect and will not commit
-    // results for SQLPrepare since only metadata is required for SQLPrepare
+    // This will commit results for SQLExecDirect. SQLPrepare only described
+    // the columns, there are no rows to commit
     if (commit) {
         GetNextResultSet(stmt);
     }
@@ -149,6 +206,7 @@ RETCODE ExecuteStatement(StatementClass *stmt, BOOL commit) {
 }
 
 SQLRETURN GetNextResultSet(StatementClass *stmt) {
+    CSTR func = "GetNextResultSet";
     ConnectionClass *conn = SC_get_conn(stmt);
     QResultClass *q_res = SC_get_Result(stmt);
     if ((q_res == NULL) && (conn == NULL)) {
@@ -156,25 +214,46 @@ SQLRETURN GetNextResultSet(StatementClass *stmt) {
     }
 
     SQLSMALLINT total_columns = -1;
-    if (!SQL_SUCCEEDED(SQLNumResultCols(stmt, &total_columns))
+    if (!SQL_SUCCEEDED(OPENSEARCHAPI_NumResultCols(stmt, &total_columns))
         || (total_columns == -1)) {
         return SQL_ERROR;
     }
 
-    OpenSearchResult *es_res = OpenSearchGetResult(conn->opensearchconn);
+    // A forward only cursor never returns to the rows before the current
+    // rowset, drop them before the next page is appended
+    if (conn->connInfo.streaming_cursor
+        && stmt->options.cursor_type == SQL_CURSOR_FORWARD_ONLY
+        && QR_has_valid_base(q_res) && QR_get_rowstart_in_cache(q_res) > 0) {
+        QR_discard_head_rows(q_res,
+                             (SQLULEN)QR_get_rowstart_in_cache(q_res));
+    }
+
+    OpenSearchResult *es_res = OpenSearchGetStreamResult(stmt->result_stream);
     if (es_res != NULL) {
         // Save server cursor id to fetch more pages later
-        if (es_res->opensearch_result_doc.has("cursor")) {
-            QR_set_server_cursor_id(
-                q_res, es_res->opensearch_result_doc["cursor"].as_string().c_str());
+        if (!es_res->cursor.empty()) {
+            QR_set_server_cursor_id(q_res, es_res->cursor.c_str());
         } else {
             QR_set_server_cursor_id(q_res, NULL);
         }
 
         // Responsible for looping through rows, allocating tuples and
         // appending these rows in q_result
-        CC_Append_Table_Data(es_res->opensearch_result_doc, q_res, total_columns,
-                             *(q_res->fields));
+        SQLULEN build_start = OpenSearchClockMicros();
+        CC_Append_Table_Data(*es_res, q_res, total_columns, *(q_res->fields));
+        UpdateMetrics(stmt, q_res, build_start);
+
+        // The rows were copied into the cache
+        OpenSearchClearResult(es_res);
+    } else {
+        // Retrieval ended early, no more pages will come
+        QR_set_server_cursor_id(q_res, NULL);
+        std::string es_stream_err =
+            OpenSearchGetStreamError(stmt->result_stream);
+        if (!es_stream_err.empty()) {
+            SC_set_error(stmt, STMT_EXEC_ERROR, es_stream_err.c_str(), func);
+            return SQL_ERROR;
+        }
     }
 
     return SQL_SUCCESS;
@@ -182,7 +261,14 @@ SQLRETURN GetNextResultSet(StatementClass *stmt) {
 
 RETCODE RePrepareStatement(StatementClass *stmt) {
     CSTR func = "RePrepareStatement";
+
+    // Recycling frees the statement text, which is what gets executed next
+    char *statement = stmt->statement;
+    short statement_type = stmt->statement_type;
+    stmt->statement = NULL;
     RETCODE result = SC_initialize_and_recycle(stmt);
+    stmt->statement = statement;
+    stmt->statement_type = statement_type;
     if (result != SQL_SUCCESS)
         return result;
     if (!stmt->statement) {
@@ -233,71 +319,52 @@ QResultClass *SendQueryGetResult(StatementClass *stmt, BOOL commit) {
     if (res == NULL)
         return NULL;
 
-    // Send command
+    // Send command. Without commit only the result columns are needed, they
+    // come from a schema probe instead of running the whole query
     ConnectionClass *conn = SC_get_conn(stmt);
-    if (OpenSearchExecDirect(conn->opensearchconn, stmt->statement,
-                             conn->connInfo.fetch_size)
-        != 0) {
-        QR_Destructor(res);
-        return NULL;
+    OpenSearchResult *es_res = NULL;
+    if (commit) {
+        memset(&stmt->metrics, 0, sizeof(stmt->metrics));
+        if (OpenSearchExecDirectStream(conn->opensearchconn,
+                                       stmt->result_stream, stmt->statement,
+                                       conn->connInfo.fetch_size)
+            != 0) {
+            QR_Destructor(res);
+            return NULL;
+        }
+        es_res = OpenSearchGetStreamResult(stmt->result_stream);
+    } else {
+        es_res = OpenSearchDescribe(conn->opensearchconn, stmt->result_stream,
+                                    stmt->statement);
     }
     res->rstatus = PORES_COMMAND_OK;
 
     // Get OpenSearchResult
-    OpenSearchResult *es_res = OpenSearchGetResult(conn->opensearchconn);
     if (es_res == NULL) {
         QR_Destructor(res);
         return NULL;
     }
 
+    SQLULEN build_start = OpenSearchClockMicros();
     BOOL success =
         commit
             ? CC_from_OpenSearchResult(res, conn, res->cursor_name, *es_res)
             : CC_Metadata_from_OpenSearchResult(res, conn, res->cursor_name,
                                                    *es_res);
+    if (commit)
+        UpdateMetrics(stmt, res, build_start);
+
+    // Deallocate OpenSearchResult
+    OpenSearchClearResult(es_res);
 
     // Convert result to QResultClass
     if (!success) {
         QR_Destructor(res);
         res = NULL;
     }
-
-    if (commit) {
-        // Deallocate OpenSearchResult
-        OpenSearchClearResult(es_res);
-        res->opensearch_result = NULL;
-    } else {
-        // Set OpenSearchResult into connection class so it can be used later
-        res->opensearch_result = es_res;
-    }
     return res;
 }
 
-RETCODE AssignResult(StatementClass *stmt) {
-    if (stmt == NULL)
-        return SQL_ERROR;
-
-    QResultClass *res = SC_get_Result(stmt);
-    if (!res || !res->opensearch_result) {
-        return SQL_ERROR;
-    }
-
-    // Commit result to QResultClass
-    OpenSearchResult *es_res = static_cast< OpenSearchResult * >(res->opensearch_result);
-    ConnectionClass *conn = SC_get_conn(stmt);
-    if (!CC_No_Metadata_from_OpenSearchResult(res, conn, res->cursor_name,
-                                              *es_res)) {
-        QR_Destructor(res);
-        return SQL_ERROR;
-    }
-    GetNextResultSet(stmt);
-
-    // Deallocate and return result
-    OpenSearchClearResult(es_res);
-    res->opensearch_result = NULL;
-    return SQL_SUCCESS;
-}
-
 void ClearOpenSearchResult(void *opensearch_result) {
     if (opensearch_result != NULL) {
         OpenSearchResult *es_res = static_cast< OpenSearchResult * >(opensearch_result);
@@ -319,8 +386,16 @@ SQLRETURN OPENSEARCHAPI_Cancel(HSTMT hstmt) {
     // Entry common critical section
     ENTER_COMMON_CS;
 
+    AsyncCall *call = static_cast< AsyncCall * >(stmt->async_call);
+    if (call != NULL && call->function_id != SQL_API_SQLFETCH) {
+        // The executor may not have started the statement yet, it is then
+        // refused when it does
+        opensearchtmt->cancel_info |= CancelRequestSet;
+        if (STMT_EXECUTING == opensearchtmt->status)
+            OpenSearchCancelStream(opensearchtmt->result_stream);
+    }
     // Waiting for more data from SQLParamData/SQLPutData - cancel statement
-    if (opensearchtmt->data_at_exec >= 0) {
+    else if (opensearchtmt->data_at_exec >= 0) {
         // Enter statement critical section
         ENTER_STMT_CS(stmt);
 
@@ -332,6 +407,12 @@ SQLRETURN OPENSEARCHAPI_Cancel(HSTMT hstmt) {
 
         // Leave statement critical section
         LEAVE_STMT_CS(stmt);
+    } else if (STMT_EXECUTING == opensearchtmt->status) {
+        // The executing thread holds the statement critical section, abort
+        // its requests and let it report the cancellation. Those of the other
+        // statements on the connection go on.
+        opensearchtmt->cancel_info |= CancelRequestSet;
+        OpenSearchCancelStream(opensearchtmt->result_stream);
     }
 
     // Leave common critical section
@@ -339,3 +420,90 @@ SQLRETURN OPENSEARCHAPI_Cancel(HSTMT hstmt) {
 
     return ret;
 }
+
+RETCODE StartAsyncCall(StatementClass *stmt, SQLUSMALLINT function_id,
+                       AsyncCallFunc func, void *args) {
+    AsyncCall *call = new AsyncCall(function_id);
+    ENTER_COMMON_CS;
+    stmt->async_call = call;
+    LEAVE_COMMON_CS;
+
+    DriverExecutor().submit([stmt, call, func, args]() {
+        ENTER_STMT_CS(stmt);
+        SC_clear_error(stmt);
+        RETCODE ret = func(stmt, args);
+        LEAVE_STMT_CS(stmt);
+        free(args);
+
+        std::scoped_lock lock(call->mutex);
+        call->ret = ret;
+        call->done = true;
+    });
+    return SQL_STILL_EXECUTING;
+}
+
+BOOL PollAsyncCall(StatementClass *stmt, SQLUSMALLINT function_id,
+                   RETCODE *ret) {
+    ENTER_COMMON_CS;
+    AsyncCall *call = static_cast< AsyncCall * >(stmt->async_call);
+    if (call == NULL) {
+        LEAVE_COMMON_CS;
+        return FALSE;
+    }
+    // Any other function is rejected right away, the call stays pending for
+    // its own function to collect
+    if (call->function_id != function_id) {
+        SetSequenceError(stmt, call);
+        LEAVE_COMMON_CS;
+        *ret = SQL_ERROR;
+        return TRUE;
+    }
+    ER_Destructor(call->sequence_error);
+    call->sequence_error = NULL;
+    LEAVE_COMMON_CS;
+
+    {
+        std::scoped_lock lock(call->mutex);
+        if (!call->done) {
+            *ret = SQL_STILL_EXECUTING;
+            return TRUE;
+        }
+        *ret = call->ret;
+    }
+    ReleaseAsyncCall(stmt);
+    return TRUE;
+}
+
+BOOL AsyncCallPending(StatementClass *stmt) {
+    RETCODE ret;
+    return PollAsyncCall(stmt, SQL_API_ALL_FUNCTIONS, &ret);
+}
+
+BOOL AsyncSequenceError(StatementClass *stmt, SQLSMALLINT RecNumber,
+                        SQLCHAR *szSqlState, SQLINTEGER *pfNativeError,
+                        SQLCHAR *szErrorMsg, SQLSMALLINT cbErrorMsgMax,
+                        SQLSMALLINT *pcbErrorMsg, UWORD flag, RETCODE *ret) {
+    ENTER_COMMON_CS;
+    AsyncCall *call = static_cast< AsyncCall * >(stmt->async_call);
+    BOOL rejected = (call != NULL && call->sequence_error != NULL);
+    if (rejected)
+        *ret = ER_ReturnError(call->sequence_error, RecNumber, szSqlState,
+                              pfNativeError, szErrorMsg, cbErrorMsgMax,
+                              pcbErrorMsg, flag);
+    LEAVE_COMMON_CS;
+    return rejected;
+}
+
+BOOL FetchNeedsNextPage(StatementClass *stmt) {
+    QResultClass *res = SC_get_Curres(stmt);
+    if (res == NULL || res->server_cursor_id == NULL)
+        return FALSE;
+
+    // Errs on the side of a page being needed, the fetch itself decides
+    SQLLEN rowset_size = SC_get_ARDF(stmt)->size_of_rowset;
+    SQLLEN rowset_start = SC_get_rowset_start(stmt);
+    if (rowset_start < 0)
+        rowset_start = 0;
+    return rowset_start + 2 * rowset_size
+           >= (SQLLEN)QR_get_num_total_tuples(res);
+}
@@ -18,10 +18,37 @@ RETCODE RePrepareStatement(StatementClass *stmt);
 RETCODE PrepareStatement(StatementClass* stmt, const SQLCHAR *stmt_str, SQLINTEGER stmt_sz);
 RETCODE ExecuteStatement(StatementClass *stmt, BOOL commit);
 QResultClass *SendQueryGetResult(StatementClass *stmt, BOOL commit);
-RETCODE AssignResult(StatementClass *stmt);
 SQLRETURN OPENSEARCHAPI_Cancel(HSTMT hstmt);
 SQLRETURN GetNextResultSet(StatementClass *stmt);
 void ClearOpenSearchResult(void *opensearch_result);
+
+/* Asynchronous execution (SQL_ATTR_ASYNC_ENABLE). StartAsyncCall runs func on
+ * the driver executor, holding the statement critical section, and returns
+ * SQL_STILL_EXECUTING. args are freed once func returns. The application
+ * repeats the call to poll: PollAsyncCall returns TRUE while a call is
+ * pending and sets ret to SQL_STILL_EXECUTING or the result of the finished
+ * call. Any other function called meanwhile fails with HY010 without
+ * waiting, the pending call is left for its own function to collect. */
+typedef RETCODE (*AsyncCallFunc)(StatementClass *stmt, void *args);
+RETCODE StartAsyncCall(StatementClass *stmt, SQLUSMALLINT function_id,
+                       AsyncCallFunc func, void *args);
+BOOL PollAsyncCall(StatementClass *stmt, SQLUSMALLINT function_id,
+                   RETCODE *ret);
+/* TRUE, with the sequence error recorded, if a call is pending. Checked by
+ * the statement functions that never run asynchronously. */
+BOOL AsyncCallPending(StatementClass *stmt);
+/* Returns the sequence error of a rejected function to the diagnostics
+ * functions, TRUE if there is one */
+BOOL AsyncSequenceError(StatementClass *stmt, SQLSMALLINT RecNumber,
+                        SQLCHAR *szSqlState, SQLINTEGER *pfNativeError,
+                        SQLCHAR *szErrorMsg, SQLSMALLINT cbErrorMsgMax,
+                        SQLSMALLINT *pcbErrorMsg, UWORD flag, RETCODE *ret);
+/* SQLExecDirect[W] as an AsyncCallFunc, defined in odbcapi.c */
+RETCODE AsyncExecDirect(StatementClass *stmt, void *args);
+/* TRUE if the next SQLFetch may have to wait for a result page */
+BOOL FetchNeedsNextPage(StatementClass *stmt);
+#define SC_is_async(stmt) \
+    (SQL_ASYNC_ENABLE_ON == (stmt)->options.async_enable)
 #ifdef __cplusplus
 }
 #endif
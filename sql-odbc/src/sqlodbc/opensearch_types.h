@@ -238,6 +238,21 @@ typedef enum {
     CONN_ERROR_UNABLE_TO_ESTABLISH  // 08001
 } ConnErrorType;
 
+// Counters of the last execution of a statement, read with SQLGetStmtAttr(
+// SQL_ATTR_ESOPT_STATEMENT_METRICS). Times are in microseconds.
+typedef struct OpenSearchStatementMetrics {
+    SQLULEN http_time_us;     // requests of the query, its cursor pages and
+                              // the cursor close
+    SQLULEN bytes_received;   // response bodies
+    SQLULEN parse_time_us;    // JSON decoding of the pages
+    SQLULEN build_time_us;    // copying the pages into the tuple cache
+    SQLULEN convert_time_us;  // conversions to the application buffers
+    SQLULEN pages_fetched;    // pages requested from the server
+    SQLULEN queue_wait_us;    // waiting on pages that were not ready yet
+    SQLULEN peak_cache_bytes; // largest size of the tuple cache
+    SQLULEN sign_time_us;     // authenticating the requests
+} OpenSearchStatementMetrics;
+
 // Only expose this to C++ code, this will be passed through the C interface as
 // a void*
 #ifdef __cplusplus
@@ -276,6 +291,17 @@ typedef struct connection_options {
     std::string port;
     std::string timeout;
     std::string fetch_size;
+    // Defaults of the DSN, so callers may list only the members above
+    bool use_dom_parser = false;
+    std::string prefetch_depth = "2";
+    bool skip_cursor_validation = false;
+    std::string query_cache_ttl = "0";
+    std::string query_cache_size = "64";
+    std::string metadata_cache_ttl = "0";
+    bool shared_metadata_cache = false;
+    std::string io_threads = "0";
+    std::string response_format = "jdbc";
+    bool compression = false;
 } connection_options;
 
 typedef struct runtime_options {
@@ -297,6 +323,13 @@ typedef struct ErrorDetails {
     }
 } ErrorDetails;
 
+// Cluster details read from the root endpoint in a single request
+typedef struct ServerInfo {
+    std::string version;
+    std::string distribution;
+    std::string cluster_name;
+} ServerInfo;
+
 #define INVALID_OID 0
 #define KEYWORD_TYPE_OID 1043
 #define KEYWORD_TYPE_SIZE 255
@@ -324,6 +357,21 @@ typedef struct ColumnInfo {
     }
 } ColumnInfo;
 
+// Location of a single datarows cell, use OpenSearchResult::CellText to read
+// it. A negative length marks a JSON null. Numbers and booleans also carry the
+// value decoded by the parser, the text is kept for character conversions.
+enum class CellType : uint8_t { TEXT, INTEGER, DOUBLE, BOOL };
+typedef struct DataCell {
+    size_t offset;
+    int32_t length;
+    CellType type;
+    bool in_body;  // text is inside result_json rather than cell_data
+    union {
+        int64_t integer;  // INTEGER and BOOL
+        double number;    // DOUBLE
+    };
+} DataCell;
+
 typedef struct OpenSearchResult {
     uint32_t ref_count;  // reference count. A ColumnInfo can be shared by
                          // several qresults.
@@ -333,11 +381,34 @@ typedef struct OpenSearchResult {
     std::string result_json;
     std::string command_type;  // SELECT / FETCH / etc
     rabbit::document opensearch_result_doc;
+
+    // Filled by the streaming response parser instead of
+    // opensearch_result_doc. Cells are stored row-major, row_width per row.
+    // The parser decodes result_json in place, so string and number cells
+    // point into it. cell_data only holds text the response does not
+    // contain verbatim (booleans and nested values). Cell text is not null
+    // terminated, text_size is what it takes once copied with terminators.
+    bool streamed;
+    std::vector< std::pair< std::string, std::string > > schema;
+    std::vector< DataCell > datarows;
+    std::string cell_data;
+    size_t text_size;
+    size_t num_rows;
+    size_t row_width;
     OpenSearchResult() {
         ref_count = 0;
         num_fields = 0;
         result_json = "";
         command_type = "";
+        streamed = false;
+        text_size = 0;
+        num_rows = 0;
+        row_width = 0;
+    }
+
+    const char* CellText(const DataCell& cell) const {
+        return (cell.in_body ? result_json.data() : cell_data.data())
+               + cell.offset;
     }
 } OpenSearchResult;
 
@@ -27,7 +27,18 @@ static RETCODE set_statement_option(ConnectionClass *conn, StatementClass *stmt,
     else
         ci = &(SC_get_conn(stmt)->connInfo);
     switch (fOption) {
-        case SQL_ASYNC_ENABLE: /* ignored */
+        case SQL_ASYNC_ENABLE:
+            MYLOG(OPENSEARCH_DEBUG, "SQL_ASYNC_ENABLE, vParam = " FORMAT_LEN "\n",
+                  vParam);
+            setval = (SQL_ASYNC_ENABLE_ON == vParam) ? SQL_ASYNC_ENABLE_ON
+                                                     : SQL_ASYNC_ENABLE_OFF;
+            if (conn)
+                conn->stmtOptions.async_enable = setval;
+            if (stmt)
+                stmt->options.async_enable = stmt->options_orig.async_enable =
+                    setval;
+            if (setval != vParam)
+                changed = TRUE;
             break;
 
         case SQL_BIND_TYPE:
@@ -636,8 +647,8 @@ RETCODE SQL_API OPENSEARCHAPI_GetStmtOption(HSTMT hstmt, SQLUSMALLINT fOption,
 
             break;
 
-        case SQL_ASYNC_ENABLE: /* NOT SUPPORTED */
-            *((SQLINTEGER *)pvParam) = SQL_ASYNC_ENABLE_OFF;
+        case SQL_ASYNC_ENABLE:
+            *((SQLULEN *)pvParam) = stmt->options.async_enable;
             break;
 
         case SQL_BIND_TYPE:
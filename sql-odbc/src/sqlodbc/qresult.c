@@ -143,6 +143,7 @@ QResultClass *QR_Constructor(void) {
         rv->num_total_read = 0;
         rv->num_cached_rows = 0;
         rv->num_cached_keys = 0;
+        rv->num_discarded_rows = 0;
         rv->fetch_number = 0;
         rv->flags =
             0; /* must be cleared before calling QR_set_rowstart_in_cache() */
@@ -154,6 +155,7 @@ QResultClass *QR_Constructor(void) {
         rv->num_fields = 0;
         rv->num_key_fields = OPENSEARCH_NUM_NORMAL_KEYS; /* CTID + OID */
         rv->tupleField = NULL;
+        TA_init(&rv->arena);
         rv->cursor_name = NULL;
         rv->aborted = FALSE;
 
@@ -356,6 +358,43 @@ void QR_add_notice(QResultClass *self, const char *msg) {
     }
 }
 
+/*
+ *	Drop the first count cached rows once a forward only cursor has moved
+ *	past them. The remaining rows move to the front of backend_tuples and the
+ *	arena blocks only the dropped rows used are freed, so the cache does not
+ *	grow with the size of the result.
+ */
+void QR_discard_head_rows(QResultClass *self, SQLULEN count) {
+    UInt2 num_fields = self->num_fields;
+    SQLULEN remaining, i;
+    const char *oldest = NULL;
+
+    if (count > self->num_cached_rows)
+        count = self->num_cached_rows;
+    if (0 == count || NULL == self->backend_tuples || QR_haskeyset(self))
+        return;
+    MYLOG(OPENSEARCH_DEBUG, "discarding " FORMAT_ULEN " of " FORMAT_ULEN
+          " cached rows\n", count, self->num_cached_rows);
+
+    ClearCachedRows(self->backend_tuples, num_fields, count);
+    remaining = self->num_cached_rows - count;
+    memmove(self->backend_tuples, self->backend_tuples + count * num_fields,
+            remaining * num_fields * sizeof(TupleField));
+    memset(self->backend_tuples + remaining * num_fields, 0,
+           count * num_fields * sizeof(TupleField));
+    self->num_cached_rows = remaining;
+    self->num_discarded_rows += count;
+    self->base -= count;
+    self->tupleField = NULL;
+
+    /* values are carved out of the arena in row order */
+    for (i = 0; i < remaining * num_fields && NULL == oldest; i++) {
+        if (self->backend_tuples[i].arena)
+            oldest = self->backend_tuples[i].value;
+    }
+    TA_release_older(&self->arena, oldest);
+}
+
 TupleField *QR_AddNew(QResultClass *self) {
     size_t alloc;
     UInt4 num_fields;
@@ -409,6 +448,7 @@ void QR_free_memory(QResultClass *self) {
         self->dataFilled = FALSE;
         self->tupleField = NULL;
     }
+    TA_release(&self->arena);
     if (self->keyset) {
         free(self->keyset);
         self->keyset = NULL;
@@ -468,6 +508,7 @@ void QR_free_memory(QResultClass *self) {
     self->num_total_read = 0;
     self->num_cached_rows = 0;
     self->num_cached_keys = 0;
+    self->num_discarded_rows = 0;
     self->cursTuple = -1;
     self->pstatus = 0;
 
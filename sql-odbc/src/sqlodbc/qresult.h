@@ -59,6 +59,7 @@ struct QResultClass_ {
     SQLULEN move_offset;
     SQLLEN base; /* relative position of rowset start in the current data
                     cache(backend_tuples) */
+    SQLULEN num_discarded_rows; /* rows dropped from the front of the cache */
 
     UInt2 num_fields;                   /* number of fields in the result */
     UInt2 num_key_fields;               /* number of key fields in the result */
@@ -78,6 +79,7 @@ struct QResultClass_ {
 
     TupleField *backend_tuples; /* data from the backend (the tuple cache) */
     TupleField *tupleField;     /* current backend tuple being retrieved */
+    TupleArena arena;           /* storage for the backend tuple values */
 
     char pstatus;                   /* processing status */
     char aborted;                   /* was aborted ? */
@@ -129,8 +131,11 @@ enum {
 
 /*	These functions are for retrieving data from the qresult */
 #define QR_get_value_backend(self, fieldno) (self->tupleField[fieldno].value)
+#define QR_get_field_backend(self, fieldno) (&self->tupleField[fieldno])
 #define QR_get_value_backend_row(self, tupleno, fieldno) \
     ((self->backend_tuples + (tupleno * self->num_fields))[fieldno].value)
+#define QR_get_field_backend_row(self, tupleno, fieldno) \
+    (&(self->backend_tuples + (tupleno * self->num_fields))[fieldno])
 #define QR_get_value_backend_text(self, tupleno, fieldno) \
     QR_get_value_backend_row(self, tupleno, fieldno)
 #define QR_get_value_backend_int(self, tupleno, fieldno, isNull) \
@@ -251,6 +256,7 @@ TupleField *QR_AddNew(QResultClass *self);
 void QR_close_result(QResultClass *self, BOOL destroy);
 void QR_reset_for_re_execute(QResultClass *self);
 void QR_free_memory(QResultClass *self);
+void QR_discard_head_rows(QResultClass *self, SQLULEN count);
 void QR_set_command(QResultClass *self, const char *msg);
 void QR_set_message(QResultClass *self, const char *msg);
 void QR_add_message(QResultClass *self, const char *msg);
@@ -279,6 +285,16 @@ void QR_set_server_cursor_id(QResultClass *self, const char *server_cursor_id);
             return r;                                  \
         }                                              \
     } while (0)
+#define QR_ARENA_ALLOC_return_with_error(t, s, a, m, r) \
+    do {                                                  \
+        if (t = TA_alloc(&(a)->arena, s), NULL == t) {    \
+            QR_set_rstatus(a, PORES_NO_MEMORY_ERROR);     \
+            qlog("QR_ARENA_ALLOC_error\n");                \
+            QR_free_memory(a);                            \
+            QR_set_messageref(a, m);                      \
+            return r;                                     \
+        }                                                 \
+    } while (0)
 #define QR_REALLOC_return_with_error(t, tp, s, a, m, r) \
     do {                                                \
         tp *tmp;                                        \
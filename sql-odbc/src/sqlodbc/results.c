@@ -773,11 +773,13 @@ RETCODE SQL_API OPENSEARCHAPI_GetData(HSTMT hstmt, SQLUSMALLINT icol,
     SQLLEN num_rows;
     OID field_type;
     int atttypmod;
+    TupleField *tuple_field = NULL;
     void *value = NULL;
     RETCODE result = SQL_SUCCESS;
     char get_bookmark = FALSE;
     SQLSMALLINT target_type;
     int precision = -1;
+    SQLULEN convert_start;
 #ifdef WITH_UNIXODBC
     SQLCHAR dum_rgb[2] = "\0\0";
 #endif /* WITH_UNIXODBC */
@@ -891,7 +893,8 @@ RETCODE SQL_API OPENSEARCHAPI_GetData(HSTMT hstmt, SQLUSMALLINT icol,
 
         if (!get_bookmark) {
             SQLLEN curt = GIdx2CacheIdx(stmt->currTuple, stmt, res);
-            value = QR_get_value_backend_row(res, curt, icol);
+            tuple_field = QR_get_field_backend_row(res, curt, icol);
+            value = tuple_field->value;
             MYLOG(OPENSEARCH_DEBUG,
                   "currT=" FORMAT_LEN " base=" FORMAT_LEN " rowset=" FORMAT_LEN
                   "\n",
@@ -912,7 +915,8 @@ RETCODE SQL_API OPENSEARCHAPI_GetData(HSTMT hstmt, SQLUSMALLINT icol,
             /** value = QR_get_value_backend(res, icol); maybe thiw doesn't work
              */
             SQLLEN curt = GIdx2CacheIdx(stmt->currTuple, stmt, res);
-            value = QR_get_value_backend_row(res, curt, icol);
+            tuple_field = QR_get_field_backend_row(res, curt, icol);
+            value = tuple_field->value;
         }
         MYLOG(OPENSEARCH_DEBUG, "  socket: value = '%s'\n", NULL_IF_NULL(value));
     }
@@ -950,9 +954,12 @@ RETCODE SQL_API OPENSEARCHAPI_GetData(HSTMT hstmt, SQLUSMALLINT icol,
 
     SC_set_current_col(stmt, icol);
 
-    result = (RETCODE)copy_and_convert_field(stmt, field_type, atttypmod, value,
-                                             target_type, precision, rgbValue,
-                                             cbValueMax, pcbValue, pcbValue);
+    convert_start = OpenSearchClockMicros();
+    result = (RETCODE)copy_and_convert_field(stmt, field_type, atttypmod,
+                                             tuple_field, target_type,
+                                             precision, rgbValue, cbValueMax,
+                                             pcbValue, pcbValue);
+    stmt->metrics.convert_time_us += OpenSearchClockMicros() - convert_start;
 
     switch (result) {
         case COPY_OK:
@@ -1376,7 +1383,9 @@ RETCODE SQL_API OPENSEARCHAPI_ExtendedFetch(HSTMT hstmt, SQLUSMALLINT fFetchType
             const SQLLEN end_rowset_size = rowset_start + rowsetSize;
             while ((end_rowset_size >= num_tuples)
                    && (NULL != res->server_cursor_id)) {
-                GetNextResultSet(stmt);
+                // A cursor page failed, the rows before it were fetched
+                if (GetNextResultSet(stmt) == SQL_ERROR)
+                    return SQL_ERROR;
                 num_tuples = QR_get_num_total_tuples(res);
             }
         }
@@ -1421,7 +1430,8 @@ RETCODE SQL_API OPENSEARCHAPI_ExtendedFetch(HSTMT hstmt, SQLUSMALLINT fFetchType
     QR_set_reqsize(res, (Int4)reqsize);
     /* currTuple is always 1 row prior to the rowset start */
     stmt->currTuple = RowIdx2GIdx(-1, stmt);
-    QR_set_rowstart_in_cache(res, SC_get_rowset_start(stmt));
+    QR_set_rowstart_in_cache(
+        res, SC_get_rowset_start(stmt) - (SQLLEN)res->num_discarded_rows);
 
     /* Physical Row advancement occurs for each row fetched below */
 
@@ -1430,80 +1440,92 @@ RETCODE SQL_API OPENSEARCHAPI_ExtendedFetch(HSTMT hstmt, SQLUSMALLINT fFetchType
     truncated = error = FALSE;
 
     currp = -1;
-    stmt->bind_row = 0; /* set the binding location */
-    result = SC_fetch(stmt);
-    if (SQL_ERROR == result)
-        goto cleanup;
-    if (SQL_NO_DATA_FOUND != result && res->keyset) {
-        currp = GIdx2KResIdx(SC_get_rowset_start(stmt), stmt, res);
-        MYLOG(OPENSEARCH_ALL, "currp=" FORMAT_LEN "\n", currp);
-        if (currp < 0) {
-            result = SQL_ERROR;
-            MYLOG(OPENSEARCH_DEBUG,
-                  "rowset_start=" FORMAT_LEN " but currp=" FORMAT_LEN "\n",
-                  SC_get_rowset_start(stmt), currp);
-            SC_set_error(stmt, STMT_INTERNAL_ERROR,
-                         "rowset_start not in the keyset", func);
+    if (SC_can_fetch_rowset(stmt, rowsetSize)) {
+        /* no per row state to maintain, fill the bound arrays by column */
+        result = SC_fetch_rowset(stmt, rowsetSize, &i);
+        if (SQL_ERROR == result)
             goto cleanup;
-        }
-    }
-    for (i = 0, fc_io = 0; SQL_NO_DATA_FOUND != result && SQL_ERROR != result;
-         currp++) {
-        fc_io++;
-        currp_is_valid = FALSE;
-        if (res->keyset) {
-            if ((SQLULEN)currp < res->num_cached_keys) {
-                currp_is_valid = TRUE;
-                res->keyset[currp].status &=
-                    ~CURS_IN_ROWSET; /* Off the flag first */
-            } else {
-                MYLOG(OPENSEARCH_DEBUG, "Umm current row is out of keyset\n");
-                break;
+        if (SQL_SUCCESS_WITH_INFO == result)
+            truncated = TRUE;
+        for (fc_io = 0; fc_io < i; fc_io++)
+            if (rgfRowStatus)
+                rgfRowStatus[fc_io] = SQL_ROW_SUCCESS;
+    } else {
+        stmt->bind_row = 0; /* set the binding location */
+        result = SC_fetch(stmt);
+        if (SQL_ERROR == result)
+            goto cleanup;
+        if (SQL_NO_DATA_FOUND != result && res->keyset) {
+            currp = GIdx2KResIdx(SC_get_rowset_start(stmt), stmt, res);
+            MYLOG(OPENSEARCH_ALL, "currp=" FORMAT_LEN "\n", currp);
+            if (currp < 0) {
+                result = SQL_ERROR;
+                MYLOG(OPENSEARCH_DEBUG,
+                      "rowset_start=" FORMAT_LEN " but currp=" FORMAT_LEN "\n",
+                      SC_get_rowset_start(stmt), currp);
+                SC_set_error(stmt, STMT_INTERNAL_ERROR,
+                             "rowset_start not in the keyset", func);
+                goto cleanup;
             }
         }
-        MYLOG(OPENSEARCH_ALL, "ExtFetch result=%d\n", result);
-        if (currp_is_valid && SQL_SUCCESS_WITH_INFO == result
-            && 0 == stmt->last_fetch_count) {
-            MYLOG(OPENSEARCH_ALL, "just skipping deleted row " FORMAT_LEN "\n", currp);
-            if (rowsetSize - i + fc_io > reqsize)
-                QR_set_reqsize(res, (Int4)(rowsetSize - i + fc_io));
-            result = SC_fetch(stmt);
-            if (SQL_ERROR == result)
-                break;
-            continue;
-        }
+        for (i = 0, fc_io = 0;
+             SQL_NO_DATA_FOUND != result && SQL_ERROR != result; currp++) {
+            fc_io++;
+            currp_is_valid = FALSE;
+            if (res->keyset) {
+                if ((SQLULEN)currp < res->num_cached_keys) {
+                    currp_is_valid = TRUE;
+                    res->keyset[currp].status &=
+                        ~CURS_IN_ROWSET; /* Off the flag first */
+                } else {
+                    MYLOG(OPENSEARCH_DEBUG, "Umm current row is out of keyset\n");
+                    break;
+                }
+            }
+            MYLOG(OPENSEARCH_ALL, "ExtFetch result=%d\n", result);
+            if (currp_is_valid && SQL_SUCCESS_WITH_INFO == result
+                && 0 == stmt->last_fetch_count) {
+                MYLOG(OPENSEARCH_ALL, "just skipping deleted row " FORMAT_LEN "\n", currp);
+                if (rowsetSize - i + fc_io > reqsize)
+                    QR_set_reqsize(res, (Int4)(rowsetSize - i + fc_io));
+                result = SC_fetch(stmt);
+                if (SQL_ERROR == result)
+                    break;
+                continue;
+            }
 
-        /* Determine Function status */
-        if (result == SQL_SUCCESS_WITH_INFO)
-            truncated = TRUE;
-        else if (result == SQL_ERROR)
-            error = TRUE;
-
-        /* Determine Row Status */
-        if (rgfRowStatus) {
-            if (result == SQL_ERROR)
-                *(rgfRowStatus + i) = SQL_ROW_ERROR;
-            else if (currp_is_valid) {
-                pstatus = (res->keyset[currp].status & KEYSET_INFO_PUBLIC);
-                if (pstatus != 0 && pstatus != SQL_ROW_ADDED) {
-                    rgfRowStatus[i] = pstatus;
+            /* Determine Function status */
+            if (result == SQL_SUCCESS_WITH_INFO)
+                truncated = TRUE;
+            else if (result == SQL_ERROR)
+                error = TRUE;
+
+            /* Determine Row Status */
+            if (rgfRowStatus) {
+                if (result == SQL_ERROR)
+                    *(rgfRowStatus + i) = SQL_ROW_ERROR;
+                else if (currp_is_valid) {
+                    pstatus = (res->keyset[currp].status & KEYSET_INFO_PUBLIC);
+                    if (pstatus != 0 && pstatus != SQL_ROW_ADDED) {
+                        rgfRowStatus[i] = pstatus;
+                    } else
+                        rgfRowStatus[i] = SQL_ROW_SUCCESS;
+                    /* refresh the status */
+                    /* if (SQL_ROW_DELETED != pstatus) */
+                    res->keyset[currp].status &= (~KEYSET_INFO_PUBLIC);
                 } else
-                    rgfRowStatus[i] = SQL_ROW_SUCCESS;
-                /* refresh the status */
-                /* if (SQL_ROW_DELETED != pstatus) */
-                res->keyset[currp].status &= (~KEYSET_INFO_PUBLIC);
-            } else
-                *(rgfRowStatus + i) = SQL_ROW_SUCCESS;
+                    *(rgfRowStatus + i) = SQL_ROW_SUCCESS;
+            }
+            if (SQL_ERROR != result && currp_is_valid)
+                res->keyset[currp].status |=
+                    CURS_IN_ROWSET; /* This is the unique place where the
+                                       CURS_IN_ROWSET bit is turned on */
+            i++;
+            if (i >= rowsetSize)
+                break;
+            stmt->bind_row = (SQLSETPOSIROW)i; /* set the binding location */
+            result = SC_fetch(stmt);
         }
-        if (SQL_ERROR != result && currp_is_valid)
-            res->keyset[currp].status |=
-                CURS_IN_ROWSET; /* This is the unique place where the
-                                   CURS_IN_ROWSET bit is turned on */
-        i++;
-        if (i >= rowsetSize)
-            break;
-        stmt->bind_row = (SQLSETPOSIROW)i; /* set the binding location */
-        result = SC_fetch(stmt);
     }
     if (SQL_ERROR == result)
         goto cleanup;
@@ -1595,13 +1617,16 @@ SQLLEN ClearCachedRows(TupleField *tuple, int num_fields, SQLLEN num_rows) {
     SQLLEN i;
 
     for (i = 0; i < num_fields * num_rows; i++, tuple++) {
-        if (tuple->value) {
+        /* arena values go away with the arena itself */
+        if (tuple->value && !tuple->arena) {
             MYLOG(OPENSEARCH_ALL,
                   "freeing tuple[" FORMAT_LEN "][" FORMAT_LEN "].value=%p\n",
                   i / num_fields, i % num_fields, tuple->value);
             free(tuple->value);
-            tuple->value = NULL;
         }
+        tuple->value = NULL;
+        tuple->arena = FALSE;
+        tuple->native = TUPLE_NATIVE_NONE;
         tuple->len = -1;
     }
     return i;
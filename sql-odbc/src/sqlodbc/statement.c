@@ -153,7 +153,7 @@ RETCODE SQL_API OPENSEARCHAPI_FreeStmt(HSTMT hstmt, SQLUSMALLINT fOption) {
     if (fOption == SQL_DROP) {
         ConnectionClass *conn = stmt->hdbc;
 
-        OpenSearchStopRetrieval(conn->opensearchconn);
+        OpenSearchStopStream(stmt->result_stream);
 
         /* Remove the statement from the connection's statement list */
         if (conn) {
@@ -191,7 +191,9 @@ RETCODE SQL_API OPENSEARCHAPI_FreeStmt(HSTMT hstmt, SQLUSMALLINT fOption) {
     } else if (fOption == SQL_UNBIND)
         SC_unbind_cols(stmt);
     else if (fOption == SQL_CLOSE) {
-        OpenSearchStopRetrieval(stmt->hdbc->opensearchconn);
+        OpenSearchStopStream(stmt->result_stream);
+        if (SC_get_Result(stmt))
+            SC_log_metrics(stmt);
 
         /*
          * this should discard all the results, but leave the statement
@@ -332,6 +334,9 @@ StatementClass *SC_Constructor(ConnectionClass *conn) {
         rv->allocated_callbacks = 0;
         rv->num_callbacks = 0;
         rv->callbacks = NULL;
+        rv->async_call = NULL;
+        rv->result_stream = OpenSearchCreateStream();
+        memset(&rv->metrics, 0, sizeof(rv->metrics));
         GetDataInfoInitialize(SC_get_GDTI(rv));
         PutDataInfoInitialize(SC_get_PDTI(rv));
         rv->lock_CC_for_rb = FALSE;
@@ -381,6 +386,7 @@ char SC_Destructor(StatementClass *self) {
     cancelNeedDataState(self);
     if (self->callbacks)
         free(self->callbacks);
+    OpenSearchDestroyStream(self->result_stream);
 
     DELETE_STMT_CS(self);
     free(self);
@@ -1001,7 +1007,13 @@ RETCODE SQL_API OPENSEARCHAPI_StmtError(SQLHSTMT hstmt, SQLSMALLINT RecNumber,
     OpenSearch_ErrorInfo *opensearch_error, error;
     StatementClass *stmt = (StatementClass *)hstmt;
     int errnum = SC_get_errornumber(stmt);
+    RETCODE ret;
 
+    /* A function rejected while an asynchronous call is pending reports
+     * HY010, the diagnostics of the call stay for when it is collected */
+    if (AsyncSequenceError(stmt, RecNumber, szSqlState, pfNativeError,
+                           szErrorMsg, cbErrorMsgMax, pcbErrorMsg, flag, &ret))
+        return ret;
     if (opensearch_error = SC_create_errorinfo(stmt, &error), NULL == opensearch_error)
         return SQL_NO_DATA_FOUND;
     if (opensearch_error != &error)
@@ -1038,23 +1050,90 @@ struct tm *SC_get_localtime(StatementClass *stmt) {
     return &(stmt->localtime);
 }
 
+/*
+ *	Maps the result of copy_and_convert_field_bindinfo() for column lf to
+ *	the fetch status, setting the statement error if there is one.
+ */
+static RETCODE fetch_copy_result(StatementClass *self, int retval, Int2 lf,
+                                 const char *value) {
+    CSTR func = "SC_fetch";
+    const ARDFields *opts = SC_get_ARDF(self);
+    RETCODE result = SQL_SUCCESS;
+
+    MYLOG(OPENSEARCH_DEBUG, "copy_and_convert: retval = %d\n", retval);
+
+    switch (retval) {
+        case COPY_OK:
+            break; /* OK, do next bound column */
+
+        case COPY_UNSUPPORTED_TYPE:
+            SC_set_error(self, STMT_RESTRICTED_DATA_TYPE_ERROR,
+                         "Received an unsupported type from OpenSearch.", func);
+            result = SQL_ERROR;
+            break;
+
+        case COPY_UNSUPPORTED_CONVERSION:
+            SC_set_error(self, STMT_RESTRICTED_DATA_TYPE_ERROR,
+                         "Couldn't handle the necessary data type conversion.",
+                         func);
+            result = SQL_ERROR;
+            break;
+
+        case COPY_RESULT_TRUNCATED:
+            SC_set_error(self, STMT_TRUNCATED, "Fetched item was truncated.",
+                         func);
+            MYLOG(OPENSEARCH_DEBUG, "The %dth item was truncated\n", lf + 1);
+            MYLOG(OPENSEARCH_DEBUG, "The buffer size = " FORMAT_LEN,
+                  opts->bindings[lf].buflen);
+            MYLOG(OPENSEARCH_DEBUG, " and the value is '%s'\n", value);
+            result = SQL_SUCCESS_WITH_INFO;
+            break;
+
+        case COPY_INVALID_STRING_CONVERSION: /* invalid string */
+            SC_set_error(self, STMT_STRING_CONVERSION_ERROR,
+                         "invalid string conversion occured.", func);
+            result = SQL_ERROR;
+            break;
+
+            /* error msg already filled in */
+        case COPY_GENERAL_ERROR:
+            result = SQL_ERROR;
+            break;
+
+            /* This would not be meaningful in SQLFetch. */
+        case COPY_NO_DATA_FOUND:
+            break;
+
+        default:
+            SC_set_error(self, STMT_INTERNAL_ERROR,
+                         "Unrecognized return value from "
+                         "copy_and_convert_field.",
+                         func);
+            result = SQL_ERROR;
+            break;
+    }
+
+    return result;
+}
+
 RETCODE
 SC_fetch(StatementClass *self) {
-    CSTR func = "SC_fetch";
     QResultClass *res = SC_get_Curres(self);
     ARDFields *opts;
     GetDataInfo *gdata;
     int retval;
-    RETCODE result;
+    RETCODE result, copy_result;
 
     Int2 num_cols, lf;
     OID type;
     int atttypmod;
+    TupleField *tuple_field;
     char *value;
     ColumnInfoClass *coli;
     BindInfoClass *bookmark;
     BOOL useCursor = FALSE;
     KeySet *keyset = NULL;
+    SQLULEN convert_start;
 
     /* TupleField *tupleField; */
 
@@ -1109,6 +1188,7 @@ SC_fetch(StatementClass *self) {
     gdata = SC_get_GDTI(self);
     if (gdata->allocated != opts->allocated)
         extend_getdata_info(gdata, opts->allocated, TRUE);
+    convert_start = OpenSearchClockMicros();
     for (lf = 0; lf < num_cols; lf++) {
         MYLOG(OPENSEARCH_DEBUG,
               "fetch: cols=%d, lf=%d, opts = %p, opts->bindings = %p, buffer[] "
@@ -1130,7 +1210,7 @@ SC_fetch(StatementClass *self) {
             MYLOG(OPENSEARCH_DEBUG, "type = %d, atttypmod = %d\n", type, atttypmod);
 
             if (useCursor)
-                value = QR_get_value_backend(res, lf);
+                tuple_field = QR_get_field_backend(res, lf);
             else {
                 SQLLEN curt = GIdx2CacheIdx(self->currTuple, self, res);
                 MYLOG(OPENSEARCH_DEBUG,
@@ -1139,73 +1219,140 @@ SC_fetch(StatementClass *self) {
                       res, QR_get_rowstart_in_cache(res), self->currTuple,
                       SC_get_rowset_start(self), QR_has_valid_base(res));
                 MYLOG(OPENSEARCH_DEBUG, "curt=" FORMAT_LEN "\n", curt);
-                value = QR_get_value_backend_row(res, curt, lf);
+                tuple_field = QR_get_field_backend_row(res, curt, lf);
             }
+            value = tuple_field->value;
 
             MYLOG(OPENSEARCH_DEBUG, "value = '%s'\n",
                   (value == NULL) ? "<NULL>" : value);
 
             retval = copy_and_convert_field_bindinfo(self, type, atttypmod,
-                                                     value, lf);
+                                                     tuple_field, lf);
+            copy_result = fetch_copy_result(self, retval, lf, value);
+            if (SQL_SUCCESS != copy_result)
+                result = copy_result;
+        }
+    }
+    self->metrics.convert_time_us += OpenSearchClockMicros() - convert_start;
 
-            MYLOG(OPENSEARCH_DEBUG, "copy_and_convert: retval = %d\n", retval);
+    return result;
+}
 
-            switch (retval) {
-                case COPY_OK:
-                    break; /* OK, do next bound column */
+/*
+ *	The rowset can be filled column by column when the bindings are column
+ *	wise and nothing has to be done per row (keyset, bookmark).
+ */
+BOOL SC_can_fetch_rowset(StatementClass *self, SQLLEN rowset_size) {
+    QResultClass *res = SC_get_Curres(self);
+    const ARDFields *opts = SC_get_ARDF(self);
 
-                case COPY_UNSUPPORTED_TYPE:
-                    SC_set_error(
-                        self, STMT_RESTRICTED_DATA_TYPE_ERROR,
-                        "Received an unsupported type from OpenSearch.",
-                        func);
-                    result = SQL_ERROR;
-                    break;
+    if (rowset_size <= 1 || !res || res->keyset)
+        return FALSE;
+    if (opts->bind_size > 0 || NULL == opts->bindings)
+        return FALSE;
+    if (opts->bookmark && opts->bookmark->buffer)
+        return FALSE;
+    return SQL_RD_OFF != self->options.retrieve_data;
+}
 
-                case COPY_UNSUPPORTED_CONVERSION:
-                    SC_set_error(
-                        self, STMT_RESTRICTED_DATA_TYPE_ERROR,
-                        "Couldn't handle the necessary data type conversion.",
-                        func);
-                    result = SQL_ERROR;
-                    break;
+/*
+ *	Fills a whole column-wise bound rowset from the cached rows, one column
+ *	at a time. Native numbers are stored into the bound arrays directly and
+ *	only the other values go through copy_and_convert_field(). The caller
+ *	checks SC_can_fetch_rowset() first, *fetched is the number of rows
+ *	filled.
+ */
+RETCODE SC_fetch_rowset(StatementClass *self, SQLLEN rowset_size,
+                        SQLLEN *fetched) {
+    QResultClass *res = SC_get_Curres(self);
+    ARDFields *opts = SC_get_ARDF(self);
+    GetDataInfo *gdata;
+    BindInfoClass *bic;
+    ColumnInfoClass *coli;
+    TupleField *tuple_field;
+    SQLULEN offset = opts->row_offset_ptr ? *opts->row_offset_ptr : 0;
+    SQLLEN nrows, row, curt;
+    SQLLEN *used, *indicator;
+    SQLLEN len;
+    RETCODE result = SQL_SUCCESS, copy_result;
+    Int2 num_cols, lf;
+    int retval;
+    SQLULEN convert_start;
 
-                case COPY_RESULT_TRUNCATED:
-                    SC_set_error(self, STMT_TRUNCATED,
-                                 "Fetched item was truncated.", func);
-                    MYLOG(OPENSEARCH_DEBUG, "The %dth item was truncated\n", lf + 1);
-                    MYLOG(OPENSEARCH_DEBUG, "The buffer size = " FORMAT_LEN,
-                          opts->bindings[lf].buflen);
-                    MYLOG(OPENSEARCH_DEBUG, " and the value is '%s'\n", value);
-                    result = SQL_SUCCESS_WITH_INFO;
-                    break;
+    *fetched = 0;
+    self->last_fetch_count = self->last_fetch_count_include_ommitted = 0;
+    if (!res)
+        return SQL_ERROR;
 
-                case COPY_INVALID_STRING_CONVERSION: /* invalid string */
-                    SC_set_error(self, STMT_STRING_CONVERSION_ERROR,
-                                 "invalid string conversion occured.", func);
-                    result = SQL_ERROR;
-                    break;
+    nrows = QR_get_num_total_tuples(res) - 1 - self->currTuple;
+    if (self->options.maxRows > 0
+        && self->options.maxRows - 1 - self->currTuple < nrows)
+        nrows = self->options.maxRows - 1 - self->currTuple;
+    if (nrows > rowset_size)
+        nrows = rowset_size;
+    if (nrows <= 0) {
+        self->currTuple = QR_get_num_total_tuples(res);
+        return SQL_NO_DATA_FOUND;
+    }
+    MYLOG(OPENSEARCH_DEBUG, "stmt=%p currTuple=" FORMAT_LEN " nrows=" FORMAT_LEN
+          "\n", self, self->currTuple, nrows);
 
-                    /* error msg already filled in */
-                case COPY_GENERAL_ERROR:
-                    result = SQL_ERROR;
-                    break;
+    coli = QR_get_fields(res);
+    num_cols = QR_NumPublicResultCols(res);
+    if (opts->allocated < num_cols)
+        extend_column_bindings(opts, num_cols);
+    gdata = SC_get_GDTI(self);
+    if (gdata->allocated != opts->allocated)
+        extend_getdata_info(gdata, opts->allocated, TRUE);
+    curt = GIdx2CacheIdx(self->currTuple + 1, self, res);
+    convert_start = OpenSearchClockMicros();
+    for (lf = 0; lf < num_cols; lf++) {
+        /* reset for SQLGetData */
+        GETDATA_RESET(gdata->gdata[lf]);
 
-                    /* This would not be meaningful in SQLFetch. */
-                case COPY_NO_DATA_FOUND:
-                    break;
+        bic = &(opts->bindings[lf]);
+        if (NULL == bic->buffer)
+            continue;
+        used = LENADDR_SHIFT(bic->used, offset);
+        indicator = LENADDR_SHIFT(bic->indicator, offset);
+        for (row = 0; row < nrows; row++) {
+            tuple_field = QR_get_field_backend_row(res, curt + row, lf);
+            if (NULL == tuple_field->value && NULL != indicator) {
+                indicator[row] = SQL_NULL_DATA;
+                continue;
+            }
+            if (NULL != tuple_field->value) {
+                len = copy_native_field(tuple_field, bic->returntype,
+                                        bic->buffer + offset, row, 0);
+                if (len > 0) {
+                    if (indicator)
+                        indicator[row] = 0;
+                    if (used)
+                        used[row] = len;
+                    continue;
+                }
+            }
 
-                default:
-                    SC_set_error(self, STMT_INTERNAL_ERROR,
-                                 "Unrecognized return value from "
-                                 "copy_and_convert_field.",
-                                 func);
-                    result = SQL_ERROR;
-                    break;
+            self->bind_row = (SQLSETPOSIROW)row;
+            retval = copy_and_convert_field_bindinfo(
+                self, CI_get_oid(coli, lf), CI_get_atttypmod(coli, lf),
+                tuple_field, lf);
+            copy_result =
+                fetch_copy_result(self, retval, lf, tuple_field->value);
+            if (SQL_ERROR == copy_result) {
+                self->bind_row = 0;
+                return SQL_ERROR;
             }
+            if (SQL_SUCCESS != copy_result)
+                result = copy_result;
         }
     }
+    self->bind_row = 0;
+    self->metrics.convert_time_us += OpenSearchClockMicros() - convert_start;
 
+    self->currTuple += nrows;
+    self->last_fetch_count = self->last_fetch_count_include_ommitted = nrows;
+    *fetched = nrows;
     return result;
 }
 
@@ -1247,6 +1394,23 @@ void cancelNeedDataState(StatementClass *stmt) {
     SC_reset_delegate(SQL_ERROR, stmt);
 }
 
+/*
+ *	Logs the counters of the last execution, done when its cursor is closed.
+ */
+void SC_log_metrics(const StatementClass *self) {
+    const OpenSearchStatementMetrics *m = &self->metrics;
+
+    MYLOG(OPENSEARCH_INFO,
+          "stmt=%p metrics: http=" FORMAT_ULEN "us received=" FORMAT_ULEN
+          " bytes pages=" FORMAT_ULEN " parse=" FORMAT_ULEN
+          "us build=" FORMAT_ULEN "us convert=" FORMAT_ULEN
+          "us queue_wait=" FORMAT_ULEN "us peak_cache=" FORMAT_ULEN
+          " bytes sign=" FORMAT_ULEN "us\n",
+          self, m->http_time_us, m->bytes_received, m->pages_fetched,
+          m->parse_time_us, m->build_time_us, m->convert_time_us,
+          m->queue_wait_us, m->peak_cache_bytes, m->sign_time_us);
+}
+
 void SC_log_error(const char *func, const char *desc,
                   const StatementClass *self) {
     const char *head;
@@ -286,6 +286,11 @@ struct StatementClass_ {
     UInt2 num_callbacks;
     NeedDataCallback *callbacks;
     void *cs;
+    void *async_call; /* call running on the driver executor, see
+                       * StartAsyncCall */
+    void *result_stream; /* pages of the last query, see
+                          * OpenSearchCreateStream */
+    OpenSearchStatementMetrics metrics; /* of the last execution */
 };
 
 #define SC_get_conn(a) ((a)->hdbc)
@@ -466,8 +471,12 @@ void SC_set_rowset_start(StatementClass *self, SQLLEN, BOOL);
 void SC_inc_rowset_start(StatementClass *self, SQLLEN);
 RETCODE SC_initialize_stmts(StatementClass *self, BOOL);
 RETCODE SC_fetch(StatementClass *self);
+BOOL SC_can_fetch_rowset(StatementClass *self, SQLLEN rowset_size);
+RETCODE SC_fetch_rowset(StatementClass *self, SQLLEN rowset_size,
+                        SQLLEN *fetched);
 void SC_log_error(const char *func, const char *desc,
                   const StatementClass *self);
+void SC_log_metrics(const StatementClass *self);
 time_t SC_get_time(StatementClass *self);
 struct tm *SC_get_localtime(StatementClass *self);
 int SC_Create_bookmark(StatementClass *stmt, BindInfoClass *bookmark,
@@ -12,7 +12,26 @@
 #include <stdlib.h>
 // clang-format on
 
+struct TupleArenaBlock_ {
+    TupleArenaBlock *next;
+    size_t size; /* usable bytes following this header */
+    size_t used;
+};
+
+#define TA_block_data(block) ((char *)((block) + 1))
+
+/*	Drop the current value before it is replaced, arena values are
+    reclaimed together with the arena */
+static void reset_tuplefield(TupleField *tuple_field) {
+    if (tuple_field->value && !tuple_field->arena)
+        free(tuple_field->value);
+    tuple_field->value = NULL;
+    tuple_field->arena = FALSE;
+    tuple_field->native = TUPLE_NATIVE_NONE;
+}
+
 void set_tuplefield_null(TupleField *tuple_field) {
+    reset_tuplefield(tuple_field);
     tuple_field->len = 0;
     // Changing value to strdup("") from NULL to fix error 
     // "Object cannot be cast from DBNull to other types" in Excel & Power BI
@@ -20,6 +39,7 @@ void set_tuplefield_null(TupleField *tuple_field) {
 }
 
 void set_tuplefield_string(TupleField *tuple_field, const char *string) {
+    reset_tuplefield(tuple_field);
     if (string) {
         tuple_field->len = (Int4)strlen(string); /* ES restriction */
         tuple_field->value = strdup(string);
@@ -33,6 +53,7 @@ void set_tuplefield_int2(TupleField *tuple_field, Int2 value) {
 
     ITOA_FIXED(buffer, value);
 
+    reset_tuplefield(tuple_field);
     tuple_field->len = (Int4)(strlen(buffer) + 1);
     /* +1 ... is this correct (better be on the save side-...) */
     tuple_field->value = strdup(buffer);
@@ -43,7 +64,94 @@ void set_tuplefield_int4(TupleField *tuple_field, Int4 value) {
 
     ITOA_FIXED(buffer, value);
 
+    reset_tuplefield(tuple_field);
     tuple_field->len = (Int4)(strlen(buffer) + 1);
     /* +1 ... is this correct (better be on the save side-...) */
     tuple_field->value = strdup(buffer);
 }
+
+void TA_init(TupleArena *arena) {
+    arena->blocks = NULL;
+    arena->block_size = TUPLE_ARENA_BLOCK_SIZE;
+    arena->allocated = 0;
+}
+
+static TupleArenaBlock *TA_new_block(TupleArena *arena, size_t size) {
+    TupleArenaBlock *block;
+
+    if (size < arena->block_size)
+        size = arena->block_size;
+    block = (TupleArenaBlock *)malloc(sizeof(TupleArenaBlock) + size);
+    if (NULL == block)
+        return NULL;
+    block->next = arena->blocks;
+    block->size = size;
+    block->used = 0;
+    arena->blocks = block;
+    arena->allocated += size;
+
+    /* grow the default block geometrically for big results */
+    if (arena->block_size < TUPLE_ARENA_MAX_BLOCK_SIZE)
+        arena->block_size *= 2;
+    return block;
+}
+
+/*	Make sure the next size bytes come from a single block, used to size
+    one block per cursor page */
+BOOL TA_reserve(TupleArena *arena, size_t size) {
+    TupleArenaBlock *block = arena->blocks;
+
+    if (block && block->size - block->used >= size)
+        return TRUE;
+    return NULL != TA_new_block(arena, size);
+}
+
+char *TA_alloc(TupleArena *arena, size_t size) {
+    TupleArenaBlock *block = arena->blocks;
+    char *ptr;
+
+    if (NULL == block || block->size - block->used < size) {
+        if (block = TA_new_block(arena, size), NULL == block)
+            return NULL;
+    }
+    ptr = TA_block_data(block) + block->used;
+    block->used += size;
+    return ptr;
+}
+
+void TA_release(TupleArena *arena) {
+    TupleArenaBlock *block, *next;
+
+    if (arena->blocks)
+        MYLOG(OPENSEARCH_DEBUG, "releasing " FORMAT_SIZE_T " bytes of tuple arena\n",
+              arena->allocated);
+    for (block = arena->blocks; NULL != block; block = next) {
+        next = block->next;
+        free(block);
+    }
+    TA_init(arena);
+}
+
+/*	Free the blocks allocated before the one holding value, they only hold
+    rows that were dropped from the front of the cache. With a NULL value
+    every block but the current one goes. */
+void TA_release_older(TupleArena *arena, const char *value) {
+    TupleArenaBlock *block = arena->blocks, *next;
+
+    if (NULL != value) {
+        for (; NULL != block; block = block->next) {
+            if (value >= TA_block_data(block)
+                && value < TA_block_data(block) + block->size)
+                break;
+        }
+    }
+    if (NULL == block)
+        return;
+    next = block->next;
+    block->next = NULL;
+    for (block = next; NULL != block; block = next) {
+        next = block->next;
+        arena->allocated -= block->size;
+        free(block);
+    }
+}
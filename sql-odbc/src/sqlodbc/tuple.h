@@ -14,12 +14,39 @@
 extern "C" {
 #endif
 
+/*	Type of the native copy a backend value may carry */
+enum {
+    TUPLE_NATIVE_NONE = 0,
+    TUPLE_NATIVE_INT8,
+    TUPLE_NATIVE_FLOAT8,
+    TUPLE_NATIVE_BOOL /* 0 or 1 in native_value.int8 */
+};
+
 /*	Used by backend data AND manual result sets */
 struct TupleField_ {
     Int4 len;    /* ES length of the current Tuple */
+    char arena;  /* value is owned by the result's TupleArena */
+    char native; /* TUPLE_NATIVE_* type of native_value */
     void *value; /* an array representing the value */
+    union {
+        Int8 int8;
+        double float8;
+    } native_value; /* decoded from the response, value stays the text form */
 };
 
+/*	Bump allocator for backend tuple values. Values carved out of it are
+    never freed one by one, the blocks are released together when the cached
+    rows are thrown away. */
+typedef struct TupleArenaBlock_ TupleArenaBlock;
+typedef struct TupleArena_ {
+    TupleArenaBlock *blocks; /* most recent block first */
+    size_t block_size;       /* size of the next default block */
+    size_t allocated;        /* bytes held by all the blocks */
+} TupleArena;
+
+#define TUPLE_ARENA_BLOCK_SIZE (64 * 1024)
+#define TUPLE_ARENA_MAX_BLOCK_SIZE (4 * 1024 * 1024)
+
 /*	keyset(TID + OID) info */
 struct KeySet_ {
     UWORD status;
@@ -63,6 +90,12 @@ void set_tuplefield_int2(TupleField *tuple_field, Int2 value);
 void set_tuplefield_int4(TupleField *tuple_field, Int4 value);
 SQLLEN ClearCachedRows(TupleField *tuple, int num_fields, SQLLEN num_rows);
 
+void TA_init(TupleArena *arena);
+BOOL TA_reserve(TupleArena *arena, size_t size);
+char *TA_alloc(TupleArena *arena, size_t size);
+void TA_release(TupleArena *arena);
+void TA_release_older(TupleArena *arena, const char *value);
+
 typedef struct _OPENSEARCH_BM_ {
     Int4 index;
     KeySet keys;